@@ -21,6 +21,25 @@
  *
  * Performs general operations applied to an individual classifier: creation,
  * copying, deletion, updating, and printing.
+ *
+ * Each classifier is allocated as a single cache line aligned memory block
+ * that also holds its condition and prediction when their types have a fixed
+ * size, so that a classifier is accessed without chasing separate
+ * allocations.
+ *
+ * Classifiers with neural, GP, or DGP conditions, whose evaluation is
+ * expensive, also keep an envelope: the box of the training inputs they
+ * matched during their first THETA_ENV updates. Once the envelope contains
+ * THETA_ENV inputs, inputs outside the envelope are rejected without
+ * evaluating the condition. This is approximate, since the condition may
+ * also match inputs it has not yet been trained on.
+ *
+ * When SIG_SAMPLES is set, the same classifiers also keep a match signature:
+ * a bitset of which of a fixed sample of training inputs the condition
+ * matches. Their conditions have no generality test, so for subsumption a
+ * classifier is taken to be more general than another if it matches every
+ * reference input that the other matches. Signatures are computed when first
+ * compared and recomputed once the condition or the reference inputs change.
  */
 
 #include <stdio.h>
@@ -28,6 +47,7 @@
 #include <string.h>
 #include <stdbool.h>
 #include <math.h>
+#include <float.h>
 #include "random.h"
 #include "data_structures.h"
 #include "cl.h"
@@ -37,16 +57,243 @@
 #include "cond_gp.h"
 #include "cond_dgp.h"
 #include "cond_neural.h"
+#include "cond_ternary.h"
+#include "cond_quantized.h"
 #include "pred_nlms.h"
 #include "pred_rls.h"
 #include "pred_neural.h"
 #include "rule_dgp.h"
 #include "rule_neural.h"
 
-double cl_update_err(XCSF *xcsf, CL *c, double *y);
-double cl_update_size(XCSF *xcsf, CL *c, double num_sum);
+#define CL_ALIGN 64 // classifier memory blocks start on a cache line
+#define CL_FIELD_ALIGN 16 // alignment of the condition and prediction in a block
+
+void cl_init_params(XCSF *xcsf, CL *c, int size, int time);
+void cl_vtbls(XCSF *xcsf, struct CondVtbl const **cond_vptr, struct PredVtbl const **pred_vptr);
+size_t cl_layout(XCSF *xcsf, struct CondVtbl const *cond_vptr, 
+		struct PredVtbl const *pred_vptr, size_t *cond_offset, size_t *pred_offset,
+		size_t *env_offset, size_t *sig_offset);
+size_t cl_round(size_t bytes, size_t align);
+size_t cl_env_bytes(XCSF *xcsf, struct CondVtbl const *cond_vptr);
+void cl_env_reset(XCSF *xcsf, CL *c);
+_Bool cl_env_contains(XCSF *xcsf, CL *c, double *x);
+size_t cl_sig_bytes(XCSF *xcsf, struct CondVtbl const *cond_vptr);
+int cl_sig_words(XCSF *xcsf);
+_Bool cl_sig_valid(XCSF *xcsf, CL *c);
+void cl_sig_compute(XCSF *xcsf, CL *c);
+_Bool cl_sig_general(XCSF *xcsf, CL *c1, CL *c2);
+
+CL *cl_alloc(XCSF *xcsf)
+{
+	// allocates a cache line aligned memory block for a classifier of the
+	// current condition and prediction types
+	struct CondVtbl const *cond_vptr;
+	struct PredVtbl const *pred_vptr;
+	size_t cond_offset, pred_offset, env_offset, sig_offset;
+	cl_vtbls(xcsf, &cond_vptr, &pred_vptr);
+	return aligned_alloc(CL_ALIGN, 
+			cl_layout(xcsf, cond_vptr, pred_vptr, &cond_offset, &pred_offset, &env_offset, &sig_offset));
+}
 
 void cl_init(XCSF *xcsf, CL *c, int size, int time)
+{
+	// initialises a classifier allocated with cl_alloc(); conditions and
+	// predictions of a fixed size are placed within its memory block
+	size_t cond_offset, pred_offset, env_offset, sig_offset;
+	cl_vtbls(xcsf, &c->cond_vptr, &c->pred_vptr);
+	c->block = cl_layout(xcsf, c->cond_vptr, c->pred_vptr, &cond_offset, &pred_offset, &env_offset, &sig_offset);
+	c->cond = cond_offset > 0 ? (char *) c + cond_offset : NULL;
+	c->pred = pred_offset > 0 ? (char *) c + pred_offset : NULL;
+	c->env = env_offset > 0 ? (double *) ((char *) c + env_offset) : NULL;
+	c->sig = sig_offset > 0 ? (uint64_t *) ((char *) c + sig_offset) : NULL;
+	c->sig_words = sig_offset > 0 ? cl_sig_words(xcsf) : 0;
+	cl_init_params(xcsf, c, size, time);
+	cond_init(xcsf, c);
+	pred_init(xcsf, c);
+}
+
+size_t cl_layout(XCSF *xcsf, struct CondVtbl const *cond_vptr, 
+		struct PredVtbl const *pred_vptr, size_t *cond_offset, size_t *pred_offset,
+		size_t *env_offset, size_t *sig_offset)
+{
+	// returns the size of a classifier memory block:
+	// [CL][cond][pred][env][sig]
+	// an offset is zero if allocated separately or not used
+	size_t cond_bytes = (*cond_vptr->cond_impl_bytes)(xcsf);
+	size_t pred_bytes = (*pred_vptr->pred_impl_bytes)(xcsf);
+	size_t env_bytes = cl_env_bytes(xcsf, cond_vptr);
+	size_t sig_bytes = cl_sig_bytes(xcsf, cond_vptr);
+	size_t bytes = cl_round(sizeof(CL), CL_FIELD_ALIGN);
+	*cond_offset = cond_bytes > 0 ? bytes : 0;
+	bytes += cl_round(cond_bytes, CL_FIELD_ALIGN);
+	*pred_offset = pred_bytes > 0 ? bytes : 0;
+	bytes += cl_round(pred_bytes, CL_FIELD_ALIGN);
+	*env_offset = env_bytes > 0 ? bytes : 0;
+	bytes += cl_round(env_bytes, CL_FIELD_ALIGN);
+	*sig_offset = sig_bytes > 0 ? bytes : 0;
+	bytes += cl_round(sig_bytes, CL_FIELD_ALIGN);
+	return cl_round(bytes, CL_ALIGN);
+}
+
+size_t cl_env_bytes(XCSF *xcsf, struct CondVtbl const *cond_vptr)
+{
+	// only conditions that are expensive to evaluate keep an envelope
+	if(cond_vptr == &cond_neural_vtbl || cond_vptr == &cond_gp_vtbl
+			|| cond_vptr == &cond_dgp_vtbl || cond_vptr == &rule_dgp_cond_vtbl
+			|| cond_vptr == &rule_neural_cond_vtbl) {
+		return sizeof(double) * 2 * xcsf->num_x_vars;
+	}
+	return 0;
+}
+
+void cl_env_reset(XCSF *xcsf, CL *c)
+{
+	// an empty envelope
+	c->env_size = 0;
+	if(c->env != NULL) {
+		for(int i = 0; i < xcsf->num_x_vars; i++) {
+			c->env[i] = DBL_MAX;
+			c->env[xcsf->num_x_vars + i] = -DBL_MAX;
+		}
+	}
+}
+
+void cl_env_extend(XCSF *xcsf, CL *c, double *x)
+{
+	// grows the envelope to contain a matched training input
+	double *lower = c->env;
+	double *upper = c->env + xcsf->num_x_vars;
+	for(int i = 0; i < xcsf->num_x_vars; i++) {
+		lower[i] = fmin(lower[i], x[i]);
+		upper[i] = fmax(upper[i], x[i]);
+	}
+	c->env_size++;
+}
+
+_Bool cl_env_contains(XCSF *xcsf, CL *c, double *x)
+{
+	double *lower = c->env;
+	double *upper = c->env + xcsf->num_x_vars;
+	for(int i = 0; i < xcsf->num_x_vars; i++) {
+		if(lower[i] > x[i] || upper[i] < x[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+size_t cl_sig_bytes(XCSF *xcsf, struct CondVtbl const *cond_vptr)
+{
+	// the conditions without a generality test keep a match signature
+	if(xcsf->SIG_SAMPLES > 0 && cl_env_bytes(xcsf, cond_vptr) > 0) {
+		return sizeof(uint64_t) * cl_sig_words(xcsf);
+	}
+	return 0;
+}
+
+int cl_sig_words(XCSF *xcsf)
+{
+	return (xcsf->SIG_SAMPLES + 63) / 64;
+}
+
+_Bool cl_sig_valid(XCSF *xcsf, CL *c)
+{
+	// classifiers created before SIG_SAMPLES changed have no signature of
+	// the current size
+	return c->sig != NULL && c->sig_words == cl_sig_words(xcsf);
+}
+
+void cl_sig_sample(XCSF *xcsf, double *x, int rows)
+{
+	// selects evenly spaced training inputs as the reference inputs of the
+	// match signatures; signatures computed for previous inputs become stale
+	int n = xcsf->SIG_SAMPLES < rows ? xcsf->SIG_SAMPLES : rows;
+	if(n < 1) {
+		xcsf->sig_rows = 0;
+		return;
+	}
+	xcsf->sig_x = realloc(xcsf->sig_x, sizeof(double) * n * xcsf->num_x_vars);
+	for(int i = 0; i < n; i++) {
+		memcpy(&xcsf->sig_x[i * xcsf->num_x_vars], &x[(long) i * rows / n * xcsf->num_x_vars],
+				sizeof(double) * xcsf->num_x_vars);
+	}
+	xcsf->sig_rows = n;
+	xcsf->sig_epoch++;
+}
+
+void cl_sig_compute(XCSF *xcsf, CL *c)
+{
+	// records which reference inputs the condition matches
+	for(int w = 0; w < cl_sig_words(xcsf); w++) {
+		c->sig[w] = 0;
+	}
+	for(int i = 0; i < xcsf->sig_rows; i++) {
+		if(cond_match(xcsf, c, &xcsf->sig_x[i * xcsf->num_x_vars])) {
+			c->sig[i / 64] |= 1ULL << (i % 64);
+		}
+	}
+	c->sig_epoch = xcsf->sig_epoch;
+}
+
+_Bool cl_sig_general(XCSF *xcsf, CL *c1, CL *c2)
+{
+	// returns whether c1 matches every reference input that c2 matches; c2
+	// must match at least one for the comparison to say anything
+	if(c1->sig_epoch != xcsf->sig_epoch) {
+		cl_sig_compute(xcsf, c1);
+	}
+	if(c2->sig_epoch != xcsf->sig_epoch) {
+		cl_sig_compute(xcsf, c2);
+	}
+	_Bool any = false;
+	for(int w = 0; w < cl_sig_words(xcsf); w++) {
+		if((c2->sig[w] & ~c1->sig[w]) != 0) {
+			return false;
+		}
+		any |= c2->sig[w] != 0;
+	}
+	return any;
+}
+
+size_t cl_mem(XCSF *xcsf, CL *c)
+{
+	// returns the number of bytes of memory used by a classifier
+	size_t cond_offset, pred_offset, env_offset, sig_offset;
+	return cl_layout(xcsf, c->cond_vptr, c->pred_vptr, &cond_offset, &pred_offset, &env_offset, &sig_offset) +
+		cond_heap(xcsf, c) + pred_heap(xcsf, c);
+}
+
+size_t cl_round(size_t bytes, size_t align)
+{
+	return (bytes + align - 1) / align * align;
+}
+
+_Bool cl_reinit(XCSF *xcsf, CL *c, int size, int time)
+{
+	// restores a previously initialised classifier to the state of a newly
+	// initialised one without reallocating its condition and prediction;
+	// returns false if the current condition or prediction type differs, or
+	// if the parameters have since changed the layout of its memory block
+	struct CondVtbl const *cond_vptr;
+	struct PredVtbl const *pred_vptr;
+	size_t cond_offset, pred_offset, env_offset, sig_offset;
+	cl_vtbls(xcsf, &cond_vptr, &pred_vptr);
+	if(c->cond_vptr != cond_vptr || c->pred_vptr != pred_vptr) {
+		return false;
+	}
+	size_t block = cl_layout(xcsf, cond_vptr, pred_vptr, &cond_offset, &pred_offset, &env_offset, &sig_offset);
+	if(block != c->block || (env_offset > 0) != (c->env != NULL)
+			|| (sig_offset > 0) != (c->sig != NULL)
+			|| (sig_offset > 0 && c->sig_words != cl_sig_words(xcsf))) {
+		return false;
+	}
+	cl_init_params(xcsf, c, size, time);
+	cond_reinit(xcsf, c);
+	pred_reinit(xcsf, c);
+	return true;
+}
+
+void cl_init_params(XCSF *xcsf, CL *c, int size, int time)
 {
 	c->fit = xcsf->INIT_FITNESS;
 	c->err = xcsf->INIT_ERROR;
@@ -54,18 +301,26 @@ void cl_init(XCSF *xcsf, CL *c, int size, int time)
 	c->exp = 0;
 	c->size = size;
 	c->time = time;
+	c->env_rejects = 0;
+	c->env_passes = 0;
+	cl_env_reset(xcsf, c);
+	c->sig_epoch = 0;
+}
 
+void cl_vtbls(XCSF *xcsf, struct CondVtbl const **cond_vptr, struct PredVtbl const **pred_vptr)
+{
+	// selects the condition and prediction functions for the current types
 	switch(xcsf->PRED_TYPE) {
 		case 0:
 		case 1:
-			c->pred_vptr = &pred_nlms_vtbl;
+			*pred_vptr = &pred_nlms_vtbl;
 			break;
 		case 2:
 		case 3:
-			c->pred_vptr = &pred_rls_vtbl;
+			*pred_vptr = &pred_rls_vtbl;
 			break;
 		case 4:
-			c->pred_vptr = &pred_neural_vtbl;
+			*pred_vptr = &pred_neural_vtbl;
 			break;
 		default:
 			printf("Invalid prediction type specified: %d\n", xcsf->PRED_TYPE);
@@ -74,45 +329,55 @@ void cl_init(XCSF *xcsf, CL *c, int size, int time)
 
 	switch(xcsf->COND_TYPE) {
 		case -1:
-			c->cond_vptr = &cond_dummy_vtbl;
+			*cond_vptr = &cond_dummy_vtbl;
 			break;
 		case 0:
-			c->cond_vptr = &cond_rectangle_vtbl;
+			*cond_vptr = &cond_rectangle_vtbl;
 			break;
 		case 1:
-			c->cond_vptr = &cond_ellipsoid_vtbl;
+			*cond_vptr = &cond_ellipsoid_vtbl;
 			break;
 		case 2:
-			c->cond_vptr = &cond_neural_vtbl;
+			*cond_vptr = &cond_neural_vtbl;
 			break;
 		case 3:
-			c->cond_vptr = &cond_gp_vtbl;
+			*cond_vptr = &cond_gp_vtbl;
 			break;
 		case 4:
-			c->cond_vptr = &cond_dgp_vtbl;
+			*cond_vptr = &cond_dgp_vtbl;
+			break;
+		case 5:
+			*cond_vptr = &cond_ternary_vtbl;
+			break;
+		case 6:
+			*cond_vptr = &cond_quantized_vtbl;
 			break;
 		case 11:
-			c->cond_vptr = &rule_dgp_cond_vtbl;
-			c->pred_vptr = &rule_dgp_pred_vtbl;
+			*cond_vptr = &rule_dgp_cond_vtbl;
+			*pred_vptr = &rule_dgp_pred_vtbl;
 			break;
 		case 12:
-			c->cond_vptr = &rule_neural_cond_vtbl;
-			c->pred_vptr = &rule_neural_pred_vtbl;
+			*cond_vptr = &rule_neural_cond_vtbl;
+			*pred_vptr = &rule_neural_pred_vtbl;
 			break;
 		default:
 			printf("Invalid condition type specified: %d\n", xcsf->COND_TYPE);
 			exit(EXIT_FAILURE);
 	}
-
-	cond_init(xcsf, c);
-	pred_init(xcsf, c);
 }
 
 void cl_copy(XCSF *xcsf, CL *to, CL *from)
 {
-	cl_init(xcsf, to, from->size, from->time);
+	// copies the condition and prediction into an initialised classifier
 	cond_copy(xcsf, to, from);
 	pred_copy(xcsf, to, from);
+	if(cl_sig_valid(xcsf, to) && cl_sig_valid(xcsf, from)) {
+		memcpy(to->sig, from->sig, sizeof(uint64_t) * cl_sig_words(xcsf));
+		to->sig_epoch = from->sig_epoch;
+	}
+	else {
+		to->sig_epoch = 0;
+	}
 }
 
 _Bool cl_subsumer(XCSF *xcsf, CL *c)
@@ -127,64 +392,30 @@ _Bool cl_subsumer(XCSF *xcsf, CL *c)
 
 double cl_del_vote(XCSF *xcsf, CL *c, double avg_fit)
 {
+	double vote = c->size * c->num * cl_del_mem(xcsf, c);
 	if(c->fit / c->num >= xcsf->DELTA * avg_fit || c->exp < xcsf->THETA_DEL) {
-		return c->size * c->num;
+		return vote;
 	}
-	return c->size * c->num * avg_fit / (c->fit / c->num); 
+	return vote * avg_fit / (c->fit / c->num); 
 }
 
-double cl_acc(XCSF *xcsf, CL *c)
+double cl_del_mem(XCSF *xcsf, CL *c)
 {
-	if(c->err <= xcsf->EPS_0) {
-		return 1.0;
-	}
-	else {
-		return xcsf->ALPHA * pow(c->err / xcsf->EPS_0, -(xcsf->NU));
+	// under a memory limit, deletion votes are proportional to the memory used
+	if(xcsf->MAX_POP_BYTES > 0) {
+		return c->mem;
 	}
+	return 1.0;
 }
 
-void cl_update(XCSF *xcsf, CL *c, double *x, double *y, int set_num)
+double cl_update(XCSF *xcsf, CL *c, double *x, double *y)
 {
-	c->exp++;
-	cl_update_err(xcsf, c, y);
+	// increments the experience and updates the prediction; returns the mean
+	// squared error of the prediction made for the current input, which is
+	// used for the vectorised error update of the set
+	double error = cl_update_err(xcsf, c, x, y, pred_pre);
 	pred_update(xcsf, c, y, x);
-	cl_update_size(xcsf, c, set_num);
-}
-
-double cl_update_err(XCSF *xcsf, CL *c, double *y)
-{
-	// calculate MSE
-	double error = 0.0;
-	for(int i = 0; i < xcsf->num_y_vars; i++) {
-		// prediction has been updated for the current input during set_pred()
-		double pre = pred_pre(xcsf, c, i);
-		error += (y[i] - pre) * (y[i] - pre);
-	}
-	error /= (double)xcsf->num_y_vars;
-
-	if(c->exp < 1.0/xcsf->BETA) {
-		c->err = (c->err * (c->exp-1.0) + error) / (double)c->exp;
-	}
-	else {
-		c->err += xcsf->BETA * (error - c->err);
-	}
-	return c->err * c->num;
-}
-
-void cl_update_fit(XCSF *xcsf, CL *c, double acc_sum, double acc)
-{
-	c->fit += xcsf->BETA * ((acc * c->num) / acc_sum - c->fit);
-}
-
-double cl_update_size(XCSF *xcsf, CL *c, double num_sum)
-{
-	if(c->exp < 1.0/xcsf->BETA) {
-		c->size = (c->size * (c->exp-1.0) + num_sum) / (double)c->exp; 
-	}
-	else {
-		c->size += xcsf->BETA * (num_sum - c->size);
-	}
-	return c->size * c->num;
+	return error;
 }
 
 void cl_free(XCSF *xcsf, CL *c)
@@ -212,26 +443,70 @@ void cl_print(XCSF *xcsf, CL *c, _Bool print_cond, _Bool print_pred)
 void cl_cover(XCSF *xcsf, CL *c, double *x)
 {
 	cond_cover(xcsf, c, x);
+	c->sig_epoch = 0;
+	xcsf->covers++;
 }
 
 _Bool cl_general(XCSF *xcsf, CL *c1, CL *c2)
 {
+	// conditions without a generality test are compared by their matches
+	if(cl_sig_valid(xcsf, c1) && cl_sig_valid(xcsf, c2) && xcsf->sig_rows > 0) {
+		return cl_sig_general(xcsf, c1, c2);
+	}
 	return cond_general(xcsf, c1, c2);
 }
 
 void cl_rand(XCSF *xcsf, CL *c)
 {
 	cond_rand(xcsf, c);
+	c->sig_epoch = 0;
 }
 
-_Bool cl_match(XCSF *xcsf, CL *c, double *x)
+void cl_input(XCSF *xcsf, double *x, int rows)
 {
-	return cond_match(xcsf, c, x);
+	// prepares rows new inputs stored contiguously for matching by every
+	// classifier; conditions of other types use the inputs directly
+	xcsf->x_span = NULL;
+	xcsf->qx_src = NULL;
+	xcsf->tx_src = NULL;
+	switch(xcsf->COND_TYPE) {
+		case 0:
+			cond_rectangle_input(xcsf, x, rows);
+			break;
+		case 5:
+			cond_ternary_pack(xcsf, x, rows);
+			break;
+		case 6:
+			cond_quantized_input(xcsf, x, rows);
+			break;
+		default:
+			break;
+	}
 }
 
-_Bool cl_match_state(XCSF *xcsf, CL *c)
+int cl_input_row(XCSF *xcsf, double *src, int rows, double *x)
 {
-	return cond_match_state(xcsf, c);
+	// returns the row of x within prepared inputs at src, or -1 if absent
+	uintptr_t d = (uintptr_t) x - (uintptr_t) src;
+	uintptr_t stride = sizeof(double) * xcsf->num_x_vars;
+	if(src == NULL || d % stride != 0 || d / stride >= (uintptr_t) rows) {
+		return -1;
+	}
+	return (int) (d / stride);
+}
+
+_Bool cl_match(XCSF *xcsf, CL *c, double *x)
+{
+	// the envelope is only used once grown over THETA_ENV inputs, so that
+	// classifiers created under a lower THETA_ENV keep matching until then
+	if(c->env != NULL && xcsf->THETA_ENV > 0 && c->env_size >= xcsf->THETA_ENV) {
+		if(!cl_env_contains(xcsf, c, x)) {
+			c->env_rejects++;
+			return false;
+		}
+		c->env_passes++;
+	}
+	return cond_match(xcsf, c, x);
 }
 
 double *cl_predict(XCSF *xcsf, CL *c, double *x)
@@ -241,12 +516,21 @@ double *cl_predict(XCSF *xcsf, CL *c, double *x)
 
 _Bool cl_mutate(XCSF *xcsf, CL *c)
 {
-	return cond_mutate(xcsf, c);
+	if(cond_mutate(xcsf, c)) {
+		c->sig_epoch = 0;
+		return true;
+	}
+	return false;
 }
 
 _Bool cl_crossover(XCSF *xcsf, CL *c1, CL *c2)
 {
-	return cond_crossover(xcsf, c1, c2);
+	if(cond_crossover(xcsf, c1, c2)) {
+		c1->sig_epoch = 0;
+		c2->sig_epoch = 0;
+		return true;
+	}
+	return false;
 }  
 
 double cl_mutation_rate(XCSF *xcsf, CL *c, int m)
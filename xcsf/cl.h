@@ -20,23 +20,32 @@
 
 struct CondVtbl {
 	_Bool (*cond_impl_crossover)(XCSF *xcsf, CL *c1, CL *c2);
+	_Bool (*cond_impl_equal)(XCSF *xcsf, CL *c1, CL *c2);
 	_Bool (*cond_impl_general)(XCSF *xcsf, CL *c1, CL *c2);
 	_Bool (*cond_impl_match)(XCSF *xcsf, CL *c, double *x);
-	_Bool (*cond_impl_match_state)(XCSF *xcsf, CL *c);
 	_Bool (*cond_impl_mutate)(XCSF *xcsf, CL *c);
+	_Bool (*cond_impl_box)(XCSF *xcsf, CL *c, double *lower, double *upper);
 	double (*cond_impl_mu)(XCSF *xcsf, CL *c, int m);
+	size_t (*cond_impl_bytes)(XCSF *xcsf);
+	size_t (*cond_impl_heap)(XCSF *xcsf, CL *c);
+	uint64_t (*cond_impl_hash)(XCSF *xcsf, CL *c);
 	void (*cond_impl_copy)(XCSF *xcsf, CL *to, CL *from);
 	void (*cond_impl_cover)(XCSF *xcsf, CL *c, double *x);
 	void (*cond_impl_free)(XCSF *xcsf, CL *c);
 	void (*cond_impl_init)(XCSF *xcsf, CL *c);
 	void (*cond_impl_print)(XCSF *xcsf, CL *c);
 	void (*cond_impl_rand)(XCSF *xcsf, CL *c);
+	void (*cond_impl_reinit)(XCSF *xcsf, CL *c);
 };
 
 static inline _Bool cond_crossover(XCSF *xcsf, CL *c1, CL *c2) {
 	return (*c1->cond_vptr->cond_impl_crossover)(xcsf, c1, c2);
 }
 
+static inline _Bool cond_equal(XCSF *xcsf, CL *c1, CL *c2) {
+	return (*c1->cond_vptr->cond_impl_equal)(xcsf, c1, c2);
+}
+
 static inline _Bool cond_general(XCSF *xcsf, CL *c1, CL *c2) {
 	return (*c1->cond_vptr->cond_impl_general)(xcsf, c1, c2);
 }
@@ -45,18 +54,26 @@ static inline _Bool cond_match(XCSF *xcsf, CL *c, double *x) {
 	return (*c->cond_vptr->cond_impl_match)(xcsf, c, x);
 }
 
-static inline _Bool cond_match_state(XCSF *xcsf, CL *c) {
-	return (*c->cond_vptr->cond_impl_match_state)(xcsf, c);
-}
-
 static inline _Bool cond_mutate(XCSF *xcsf, CL *c) {
 	return (*c->cond_vptr->cond_impl_mutate)(xcsf, c);
 }
 
+static inline _Bool cond_box(XCSF *xcsf, CL *c, double *lower, double *upper) {
+	return (*c->cond_vptr->cond_impl_box)(xcsf, c, lower, upper);
+}
+
 static inline double cond_mu(XCSF *xcsf, CL *c, int m) {
 	return (*c->cond_vptr->cond_impl_mu)(xcsf, c, m);
 }
 
+static inline size_t cond_heap(XCSF *xcsf, CL *c) {
+	return (*c->cond_vptr->cond_impl_heap)(xcsf, c);
+}
+
+static inline uint64_t cond_hash(XCSF *xcsf, CL *c) {
+	return (*c->cond_vptr->cond_impl_hash)(xcsf, c);
+}
+
 static inline void cond_copy(XCSF *xcsf, CL *to, CL *from) {
 	(*to->cond_vptr->cond_impl_copy)(xcsf, to, from);
 }
@@ -81,15 +98,22 @@ static inline void cond_rand(XCSF *xcsf, CL *c) {
 	(*c->cond_vptr->cond_impl_rand)(xcsf, c);
 }
 
+static inline void cond_reinit(XCSF *xcsf, CL *c) {
+	(*c->cond_vptr->cond_impl_reinit)(xcsf, c);
+}
+
 // classifier prediction    
 
 struct PredVtbl {
 	double *(*pred_impl_compute)(XCSF *xcsf, CL *c, double *x);
 	double (*pred_impl_pre)(XCSF *xcsf, CL *c, int p);
+	size_t (*pred_impl_bytes)(XCSF *xcsf);
+	size_t (*pred_impl_heap)(XCSF *xcsf, CL *c);
 	void (*pred_impl_copy)(XCSF *xcsf, CL *to,  CL *from);
 	void (*pred_impl_free)(XCSF *xcsf, CL *c);
 	void (*pred_impl_init)(XCSF *xcsf, CL *c);
 	void (*pred_impl_print)(XCSF *xcsf, CL *c);
+	void (*pred_impl_reinit)(XCSF *xcsf, CL *c);
 	void (*pred_impl_update)(XCSF *xcsf, CL *c, double *y, double *x);
 };
 
@@ -101,6 +125,10 @@ static inline double pred_pre(XCSF *xcsf, CL *c, int p) {
 	return (*c->pred_vptr->pred_impl_pre)(xcsf, c, p);
 }
 
+static inline size_t pred_heap(XCSF *xcsf, CL *c) {
+	return (*c->pred_vptr->pred_impl_heap)(xcsf, c);
+}
+
 static inline void pred_copy(XCSF *xcsf, CL *to, CL *from) {
 	(*to->pred_vptr->pred_impl_copy)(xcsf, to, from);
 }
@@ -117,28 +145,61 @@ static inline void pred_print(XCSF *xcsf, CL *c) {
 	(*c->pred_vptr->pred_impl_print)(xcsf, c);
 }
 
+static inline void pred_reinit(XCSF *xcsf, CL *c) {
+	(*c->pred_vptr->pred_impl_reinit)(xcsf, c);
+}
+
 static inline void pred_update(XCSF *xcsf, CL *c, double *y, double *x) {
 	(*c->pred_vptr->pred_impl_update)(xcsf, c, y, x);
 }
 
+// numbers of input variables with loops specialised at compile time
+#define CL_FIXED_DIMS(X) X(1) X(2) X(3) X(4) X(6) X(8) X(16)
+
+// random conditions generated by covering before one is constructed to match
+#define COVER_TRIES 16
+
 // general classifier
 _Bool cl_crossover(XCSF *xcsf, CL *c1, CL *c2);
 _Bool cl_general(XCSF *xcsf, CL *c1, CL *c2);
 _Bool cl_match(XCSF *xcsf, CL *c, double *x);
-_Bool cl_match_state(XCSF *xcsf, CL *c);
 _Bool cl_mutate(XCSF *xcsf, CL *c);
+_Bool cl_reinit(XCSF *xcsf, CL *c, int size, int time);
+CL *cl_alloc(XCSF *xcsf);
+size_t cl_mem(XCSF *xcsf, CL *c);
 _Bool cl_subsumer(XCSF *xcsf, CL *c);
 double *cl_predict(XCSF *xcsf, CL *c, double *x);
-double cl_acc(XCSF *xcsf, CL *c);
+double cl_del_mem(XCSF *xcsf, CL *c);
 double cl_del_vote(XCSF *xcsf, CL *c, double avg_fit);
+double cl_update(XCSF *xcsf, CL *c, double *x, double *y);
 void cl_copy(XCSF *xcsf, CL *to, CL *from);
 void cl_cover(XCSF *xcsf, CL *c, double *x);
+void cl_env_extend(XCSF *xcsf, CL *c, double *x);
 void cl_free(XCSF *xcsf, CL *c);
 void cl_init(XCSF *xcsf, CL *c, int size, int time);
+void cl_input(XCSF *xcsf, double *x, int rows);
+int cl_input_row(XCSF *xcsf, double *src, int rows, double *x);
 void cl_print(XCSF *xcsf, CL *c, _Bool print_cond, _Bool print_pred);
 void cl_rand(XCSF *xcsf, CL *c);
-void cl_update(XCSF *xcsf, CL *c, double *x, double *y, int set_num);
-void cl_update_fit(XCSF *xcsf, CL *c, double acc_sum, double acc);
+void cl_sig_sample(XCSF *xcsf, double *x, int rows);
+
+static inline double cl_update_err(XCSF *xcsf, CL *c, double *x, double *y,
+		double (*pre)(XCSF *xcsf, CL *c, int p)) {
+	// increments the experience and extends the envelope; returns the mean
+	// squared error of the prediction made for the current input, computed
+	// with the prediction type's pre function
+	c->exp++;
+	if(c->env != NULL && c->env_size < xcsf->THETA_ENV) {
+		cl_env_extend(xcsf, c, x);
+	}
+	double error = 0.0;
+	for(int i = 0; i < xcsf->num_y_vars; i++) {
+		// prediction has been updated for the current input during set_pred()
+		double p = (*pre)(xcsf, c, i);
+		error += (y[i] - p) * (y[i] - p);
+	}
+	return error / (double)xcsf->num_y_vars;
+}
 
 // self-adaptive mutation
 double cl_mutation_rate(XCSF *xcsf, CL *c, int m);
@@ -147,3 +208,4 @@ void sam_copy(XCSF *xcsf, double *to, double *from);
 void sam_free(XCSF *xcsf, double *mu);
 void sam_init(XCSF *xcsf, double **mu);
 void sam_print(XCSF *xcsf, double *mu);
+void sam_reinit(XCSF *xcsf, double *mu);
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2019 Richard Preen <rpreen@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **************
+ * Description:
+ **************
+ * The batch matching module.
+ *
+ * Matches a block of inputs against the whole population without covering,
+ * producing a packed bitmatrix with one row of batch_words() words per input
+ * in which bit j marks the classifier at position j of the population set.
+ * The population is processed in words of 64 classifiers, in parallel when
+ * enabled, and the inputs in tiles of BATCH_TILE rows, so that each condition
+ * is loaded once per tile of inputs rather than once per input.
+ *
+ * Conditions that also compute predictions, COND_TYPE 11 and 12, keep the
+ * outputs of their last match for prediction; their predictions therefore
+ * require each input to be matched on its own. Hyperrectangles held by a
+ * spatial index are also matched one input at a time, since the index loads
+ * only the conditions that match.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "data_structures.h"
+#include "cl.h"
+#include "cl_set.h"
+#include "cl_batch.h"
+
+#define BATCH_TILE 16 // inputs matched against a condition while it is loaded
+
+int batch_words(XCSF *xcsf)
+{
+	// returns the number of words in each row of a match bitmatrix
+	return (xcsf->pset.size + 63) / 64;
+}
+
+void batch_match(XCSF *xcsf, double *x, int rows, uint64_t *bits)
+{
+	// matches rows inputs stored contiguously at x against the population
+	int words = batch_words(xcsf);
+	cl_input(xcsf, x, rows);
+#ifdef PARALLEL_MATCH
+#pragma omp parallel for schedule(dynamic)
+#endif
+	for(int w = 0; w < words; w++) {
+		int end = w * 64 + 64 < xcsf->pset.size ? w * 64 + 64 : xcsf->pset.size;
+		for(int t = 0; t < rows; t += BATCH_TILE) {
+			int n = rows - t < BATCH_TILE ? rows - t : BATCH_TILE;
+			uint64_t tile[BATCH_TILE] = {0};
+			for(int i = w * 64; i < end; i++) {
+				CL *c = xcsf->pset.list[i];
+				for(int r = 0; r < n; r++) {
+					if(cl_match(xcsf, c, &x[(t + r) * xcsf->num_x_vars])) {
+						tile[r] |= 1ULL << (i % 64);
+					}
+				}
+			}
+			for(int r = 0; r < n; r++) {
+				bits[(t + r) * words + w] = tile[r];
+			}
+		}
+	}
+}
+
+void batch_set(XCSF *xcsf, uint64_t *row, SET *set)
+{
+	// adds the classifiers marked in a row of a match bitmatrix to the set in
+	// population order
+	for(int w = 0; w < batch_words(xcsf); w++) {
+		for(uint64_t b = row[w]; b != 0; b &= b - 1) {
+			set_add(xcsf, set, xcsf->pset.list[w * 64 + __builtin_ctzll(b)]);
+		}
+	}
+}
+
+_Bool batch_pred(XCSF *xcsf)
+{
+	// returns whether predictions are best computed from batch matching
+	if(xcsf->COND_TYPE == 11 || xcsf->COND_TYPE == 12) {
+		return false;
+	}
+	if(xcsf->COND_TYPE == 0 && xcsf->pset.size > 0
+			&& (xcsf->pop_rtree.size == xcsf->pset.size
+				|| xcsf->pop_boxes.valid)) {
+		return false;
+	}
+	return true;
+}
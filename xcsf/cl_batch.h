@@ -0,0 +1,23 @@
+/*
+ * Copyright (C) 2019 Richard Preen <rpreen@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BATCH_ROWS 1024 // inputs matched by each call when predicting in batches
+
+_Bool batch_pred(XCSF *xcsf);
+int batch_words(XCSF *xcsf);
+void batch_match(XCSF *xcsf, double *x, int rows, uint64_t *bits);
+void batch_set(XCSF *xcsf, uint64_t *row, SET *set);
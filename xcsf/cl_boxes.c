@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2019 Richard Preen <rpreen@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **************
+ * Description:
+ **************
+ * The classifier bounding box store module.
+ *
+ * Stores the condition bounding boxes of the population in structure of
+ * arrays form: for each dimension, the bounds of every classifier are
+ * contiguous and padded to a whole number of cache lines, with slot i
+ * holding the classifier at position i of the population set. An input is
+ * tested against blocks of eight boxes at a time without branching, using
+ * AVX-512 or AVX instructions when the compiler targets them, and the
+ * results are written to a bitmap from which the matching classifiers are
+ * gathered in population order.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#if defined(__AVX512F__) || defined(__AVX__)
+#include <immintrin.h>
+#endif
+#include "data_structures.h"
+#include "cl.h"
+#include "cl_set.h"
+#include "cl_boxes.h"
+
+#define BOXES_ALIGN 64 // each dimension's bounds start on a cache line
+#define BOXES_MIN_CAPACITY 64 // initial number of slots
+#define BOXES_BLOCK 8 // boxes tested together
+
+unsigned boxes_block(BOXES *b, int s, double *x);
+void boxes_grow(BOXES *b);
+
+void boxes_init(BOXES *b)
+{
+	b->lower = NULL;
+	b->upper = NULL;
+	b->bits = NULL;
+	b->dim = 0;
+	b->capacity = 0;
+	b->size = 0;
+	b->valid = false;
+}
+
+void boxes_free(BOXES *b)
+{
+	free(b->lower);
+	free(b->upper);
+	free(b->bits);
+	boxes_init(b);
+}
+
+_Bool boxes_add(XCSF *xcsf, BOXES *b, CL *c)
+{
+	// stores the box of a classifier just appended to the population; once
+	// a classifier has no box the store is invalid until rebuilt, or until
+	// the population is emptied
+	if(c->pos == 0) {
+		if(b->dim != xcsf->num_x_vars) {
+			boxes_free(b);
+		}
+		b->size = 0;
+		b->valid = true;
+	}
+	if(!b->valid) {
+		return false;
+	}
+	if(b->capacity == 0) {
+		b->dim = xcsf->num_x_vars;
+	}
+	if(b->size == b->capacity) {
+		boxes_grow(b);
+	}
+	double l[b->dim], u[b->dim];
+	if(b->size != c->pos || !cond_box(xcsf, c, l, u)) {
+		b->size = 0;
+		b->valid = false;
+		return false;
+	}
+	for(int d = 0; d < b->dim; d++) {
+		b->lower[d * b->capacity + b->size] = l[d];
+		b->upper[d * b->capacity + b->size] = u[d];
+	}
+	b->size++;
+	return true;
+}
+
+_Bool boxes_rebuild(XCSF *xcsf, BOXES *b)
+{
+	// stores the boxes of the whole population again; returns whether every
+	// classifier has a box
+	b->valid = false;
+	for(int i = 0; i < xcsf->pset.size; i++) {
+		if(!boxes_add(xcsf, b, xcsf->pset.list[i])) {
+			return false;
+		}
+	}
+	return b->valid;
+}
+
+void boxes_remove(XCSF *xcsf, BOXES *b, CL *c)
+{
+	// moves the last box into the slot of a classifier leaving the
+	// population, mirroring the population set
+	(void)xcsf;
+	if(!b->valid) {
+		return;
+	}
+	b->size--;
+	for(int d = 0; d < b->dim; d++) {
+		b->lower[d * b->capacity + c->pos] = b->lower[d * b->capacity + b->size];
+		b->upper[d * b->capacity + c->pos] = b->upper[d * b->capacity + b->size];
+	}
+}
+
+void boxes_match(XCSF *xcsf, BOXES *b, double *x, SET *set)
+{
+	// adds the population classifiers that match x to the set
+	for(int s = 0; s < b->size; s += BOXES_BLOCK) {
+		unsigned m = boxes_block(b, s, x);
+		if(b->size - s < BOXES_BLOCK) {
+			m &= (1u << (b->size - s)) - 1;
+		}
+		if(s % 64 == 0) {
+			b->bits[s / 64] = 0;
+		}
+		b->bits[s / 64] |= (uint64_t) m << (s % 64);
+	}
+	for(int w = 0; w * 64 < b->size; w++) {
+		for(uint64_t bits = b->bits[w]; bits != 0; bits &= bits - 1) {
+			CL *c = xcsf->pset.list[w * 64 + __builtin_ctzll(bits)];
+			if(cl_match(xcsf, c, x)) {
+				set_add(xcsf, set, c);
+			}
+		}
+	}
+}
+
+unsigned boxes_block(BOXES *b, int s, double *x)
+{
+	// returns a mask of the boxes in slots s to s+7 that contain x
+	unsigned m = (1u << BOXES_BLOCK) - 1;
+	for(int d = 0; d < b->dim && m != 0; d++) {
+		const double *l = &b->lower[d * b->capacity + s];
+		const double *u = &b->upper[d * b->capacity + s];
+#if defined(__AVX512F__)
+		__m512d v = _mm512_set1_pd(x[d]);
+		m &= _mm512_cmp_pd_mask(_mm512_load_pd(l), v, _CMP_LE_OQ) &
+			_mm512_cmp_pd_mask(_mm512_load_pd(u), v, _CMP_GE_OQ);
+#elif defined(__AVX__)
+		__m256d v = _mm256_set1_pd(x[d]);
+		__m256d lo = _mm256_and_pd(_mm256_cmp_pd(_mm256_load_pd(l), v, _CMP_LE_OQ),
+				_mm256_cmp_pd(_mm256_load_pd(u), v, _CMP_GE_OQ));
+		__m256d hi = _mm256_and_pd(_mm256_cmp_pd(_mm256_load_pd(l + 4), v, _CMP_LE_OQ),
+				_mm256_cmp_pd(_mm256_load_pd(u + 4), v, _CMP_GE_OQ));
+		m &= (unsigned) _mm256_movemask_pd(lo) | ((unsigned) _mm256_movemask_pd(hi) << 4);
+#else
+		unsigned dm = 0;
+		for(int k = 0; k < BOXES_BLOCK; k++) {
+			dm |= (unsigned) (l[k] <= x[d] && u[k] >= x[d]) << k;
+		}
+		m &= dm;
+#endif
+	}
+	return m;
+}
+
+void boxes_grow(BOXES *b)
+{
+	// doubles the number of slots, copying each dimension's bounds
+	int capacity = b->capacity < BOXES_MIN_CAPACITY ?
+		BOXES_MIN_CAPACITY : b->capacity * 2;
+	size_t bytes = sizeof(double) * capacity * b->dim;
+	double *lower = aligned_alloc(BOXES_ALIGN, bytes);
+	double *upper = aligned_alloc(BOXES_ALIGN, bytes);
+	// padding slots are never reported but are kept initialised
+	memset(lower, 0, bytes);
+	memset(upper, 0, bytes);
+	for(int d = 0; d < b->dim && b->size > 0; d++) {
+		memcpy(&lower[d * capacity], &b->lower[d * b->capacity], sizeof(double) * b->size);
+		memcpy(&upper[d * capacity], &b->upper[d * b->capacity], sizeof(double) * b->size);
+	}
+	free(b->lower);
+	free(b->upper);
+	b->lower = lower;
+	b->upper = upper;
+	b->capacity = capacity;
+	b->bits = realloc(b->bits, sizeof(uint64_t) * capacity / 64);
+}
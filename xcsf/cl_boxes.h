@@ -0,0 +1,23 @@
+/*
+ * Copyright (C) 2019 Richard Preen <rpreen@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+_Bool boxes_add(XCSF *xcsf, BOXES *b, CL *c);
+void boxes_free(BOXES *b);
+void boxes_init(BOXES *b);
+void boxes_match(XCSF *xcsf, BOXES *b, double *x, SET *set);
+_Bool boxes_rebuild(XCSF *xcsf, BOXES *b);
+void boxes_remove(XCSF *xcsf, BOXES *b, CL *c);
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2019 Richard Preen <rpreen@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **************
+ * Description: 
+ **************
+ * The classifier hash index module.
+ *
+ * An open addressing hash table with linear probing that indexes classifiers
+ * by a hash of their condition so that a classifier with an identical
+ * condition can be found in expected constant time. Deletions shift the
+ * following entries of the probe sequence backwards rather than leaving
+ * tombstones, so lookups never degrade as classifiers come and go.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "data_structures.h"
+#include "cl.h"
+#include "cl_index.h"
+
+#define CL_INDEX_MIN_CAPACITY 64 // initial number of slots
+
+int cl_index_home(CL_INDEX *idx, uint64_t hash);
+void cl_index_grow(CL_INDEX *idx);
+
+void cl_index_init(CL_INDEX *idx)
+{
+	idx->slot = NULL;
+	idx->capacity = 0;
+	idx->size = 0;
+}
+
+void cl_index_free(CL_INDEX *idx)
+{
+	free(idx->slot);
+	cl_index_init(idx);
+}
+
+uint64_t hash_bytes(const void *data, size_t len, uint64_t h)
+{
+	// FNV-1a hash continuing from h
+	const unsigned char *p = data;
+	for(size_t i = 0; i < len; i++) {
+		h ^= p[i];
+		h *= 1099511628211ULL;
+	}
+	return h;
+}
+
+int cl_index_home(CL_INDEX *idx, uint64_t hash)
+{
+	// mixes the hash so that all bits contribute to the slot
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+	return hash & (idx->capacity - 1);
+}
+
+void cl_index_add(XCSF *xcsf, CL_INDEX *idx, CL *c)
+{
+	// indexes a classifier; its condition must not change while indexed
+	if(2 * (idx->size + 1) > idx->capacity) {
+		cl_index_grow(idx);
+	}
+	c->hash = cond_hash(xcsf, c);
+	int i = cl_index_home(idx, c->hash);
+	while(idx->slot[i] != NULL) {
+		i = (i + 1) & (idx->capacity - 1);
+	}
+	idx->slot[i] = c;
+	idx->size++;
+}
+
+void cl_index_remove(CL_INDEX *idx, CL *c)
+{
+	int mask = idx->capacity - 1;
+	int i = cl_index_home(idx, c->hash);
+	while(idx->slot[i] != c) {
+		i = (i + 1) & mask;
+	}
+	idx->slot[i] = NULL;
+	idx->size--;
+	// move back any following entries whose home precedes the gap
+	for(int j = (i + 1) & mask; idx->slot[j] != NULL; j = (j + 1) & mask) {
+		int k = cl_index_home(idx, idx->slot[j]->hash);
+		if(((j - k) & mask) >= ((j - i) & mask)) {
+			idx->slot[i] = idx->slot[j];
+			idx->slot[j] = NULL;
+			i = j;
+		}
+	}
+}
+
+CL *cl_index_find(XCSF *xcsf, CL_INDEX *idx, CL *c)
+{
+	// returns an indexed classifier with a condition identical to c, or NULL
+	if(idx->size == 0) {
+		return NULL;
+	}
+	uint64_t hash = cond_hash(xcsf, c);
+	int i = cl_index_home(idx, hash);
+	while(idx->slot[i] != NULL) {
+		CL *d = idx->slot[i];
+		if(d->hash == hash && d->cond_vptr == c->cond_vptr && cond_equal(xcsf, d, c)) {
+			return d;
+		}
+		i = (i + 1) & (idx->capacity - 1);
+	}
+	return NULL;
+}
+
+void cl_index_grow(CL_INDEX *idx)
+{
+	// doubles the number of slots and reinserts the classifiers
+	CL **old = idx->slot;
+	int old_capacity = idx->capacity;
+	idx->capacity = old_capacity < CL_INDEX_MIN_CAPACITY ? 
+		CL_INDEX_MIN_CAPACITY : old_capacity * 2;
+	idx->slot = calloc(idx->capacity, sizeof(CL*));
+	for(int j = 0; j < old_capacity; j++) {
+		if(old[j] != NULL) {
+			int i = cl_index_home(idx, old[j]->hash);
+			while(idx->slot[i] != NULL) {
+				i = (i + 1) & (idx->capacity - 1);
+			}
+			idx->slot[i] = old[j];
+		}
+	}
+	free(old);
+}
@@ -0,0 +1,25 @@
+/*
+ * Copyright (C) 2019 Richard Preen <rpreen@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define HASH_SEED 14695981039346656037ULL // FNV-1a offset basis
+
+CL *cl_index_find(XCSF *xcsf, CL_INDEX *idx, CL *c);
+uint64_t hash_bytes(const void *data, size_t len, uint64_t h);
+void cl_index_add(XCSF *xcsf, CL_INDEX *idx, CL *c);
+void cl_index_free(CL_INDEX *idx);
+void cl_index_init(CL_INDEX *idx);
+void cl_index_remove(CL_INDEX *idx, CL *c);
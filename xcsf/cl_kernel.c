@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2019 Richard Preen <rpreen@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **************
+ * Description:
+ **************
+ * The set kernel module.
+ *
+ * The condition and prediction types rarely change during a run, yet
+ * matching, predicting, and updating a set through the classifier functions
+ * costs an indirect call through the vtables for every classifier. The loops
+ * over a set are therefore generated once for each condition type and each
+ * prediction type, calling the implementations directly so that they may be
+ * inlined and the loops optimised. A loop is only selected while every
+ * population classifier uses the functions it calls, as tracked by the
+ * population, so classifiers created before a change of type are always
+ * handled by the generic loops. Envelopes are only applied by the generic
+ * loops.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "data_structures.h"
+#include "cl.h"
+#include "cl_kernel.h"
+#include "cond_dummy.h"
+#include "cond_rectangle.h"
+#include "cond_ellipsoid.h"
+#include "cond_gp.h"
+#include "cond_dgp.h"
+#include "cond_neural.h"
+#include "cond_ternary.h"
+#include "cond_quantized.h"
+#include "pred_nlms.h"
+#include "pred_rls.h"
+#include "pred_neural.h"
+#include "rule_dgp.h"
+#include "rule_neural.h"
+
+#ifdef PARALLEL_PRED
+#define KERNEL_PARALLEL _Pragma("omp parallel for")
+#else
+#define KERNEL_PARALLEL
+#endif
+
+// writes the classifiers of list that match x to out; returns the number
+#define KERNEL_MATCH(name, match) \
+	int name(XCSF *xcsf, CL **list, int n, double *x, CL **out) \
+	{ \
+		int count = 0; \
+		for(int i = 0; i < n; i++) { \
+			out[count] = list[i]; \
+			count += match(xcsf, list[i], x); \
+		} \
+		return count; \
+	}
+
+// computes the predictions of the classifiers of list for x
+#define KERNEL_PRED(name, compute) \
+	void name(XCSF *xcsf, CL **list, int n, double *x, double **pre) \
+	{ \
+		KERNEL_PARALLEL \
+		for(int i = 0; i < n; i++) { \
+			pre[i] = compute(xcsf, list[i], x); \
+		} \
+	}
+
+// updates the classifiers of list as cl_update() does, writing the mean
+// squared error of each prediction to mse
+#define KERNEL_UPDATE(name, pre, update) \
+	void name(XCSF *xcsf, CL **list, int n, double *x, double *y, double *mse) \
+	{ \
+		for(int i = 0; i < n; i++) { \
+			CL *c = list[i]; \
+			mse[i] = cl_update_err(xcsf, c, x, y, pre); \
+			update(xcsf, c, y, x); \
+		} \
+	}
+
+KERNEL_MATCH(kernel_match_cl, cl_match)
+KERNEL_MATCH(kernel_match_dummy, cond_dummy_match)
+KERNEL_MATCH(kernel_match_rectangle, cond_rectangle_match)
+KERNEL_MATCH(kernel_match_ellipsoid, cond_ellipsoid_match)
+KERNEL_MATCH(kernel_match_neural, cond_neural_match)
+KERNEL_MATCH(kernel_match_gp, cond_gp_match)
+KERNEL_MATCH(kernel_match_dgp, cond_dgp_match)
+KERNEL_MATCH(kernel_match_ternary, cond_ternary_match)
+KERNEL_MATCH(kernel_match_quantized, cond_quantized_match)
+KERNEL_MATCH(kernel_match_rule_dgp, rule_dgp_cond_match)
+KERNEL_MATCH(kernel_match_rule_neural, rule_neural_cond_match)
+
+KERNEL_PRED(kernel_pred_cl, cl_predict)
+KERNEL_PRED(kernel_pred_nlms, pred_nlms_compute)
+KERNEL_PRED(kernel_pred_rls, pred_rls_compute)
+KERNEL_PRED(kernel_pred_neural, pred_neural_compute)
+KERNEL_PRED(kernel_pred_rule_dgp, rule_dgp_pred_compute)
+KERNEL_PRED(kernel_pred_rule_neural, rule_neural_pred_compute)
+
+KERNEL_UPDATE(kernel_update_nlms, pred_nlms_pre, pred_nlms_update)
+KERNEL_UPDATE(kernel_update_rls, pred_rls_pre, pred_rls_update)
+KERNEL_UPDATE(kernel_update_neural, pred_neural_pre, pred_neural_update)
+KERNEL_UPDATE(kernel_update_rule_dgp, rule_dgp_pred_pre, rule_dgp_pred_update)
+KERNEL_UPDATE(kernel_update_rule_neural, rule_neural_pred_pre, rule_neural_pred_update)
+
+// whether every population classifier uses the function f of the vtable
+#define KERNEL_COND(xcsf, f, impl) \
+	((xcsf)->pop_mixed == 0 && (xcsf)->pop_cond_vptr->impl == (f))
+#define KERNEL_PRED_FN(xcsf, f, impl) \
+	((xcsf)->pop_mixed == 0 && (xcsf)->pop_pred_vptr->impl == (f))
+
+int kernel_match(XCSF *xcsf, CL **list, int n, double *x, CL **out)
+{
+	// matches list against x with the loop of the population's condition
+	// type; out must have room for n classifiers
+	if(n == 0) {
+		return 0;
+	}
+	if(xcsf->THETA_ENV > 0 || xcsf->pop_mixed > 0) {
+		return kernel_match_cl(xcsf, list, n, x, out);
+	}
+#define KERNEL_MATCH_IF(f, loop) \
+	if(KERNEL_COND(xcsf, f, cond_impl_match)) { \
+		return loop(xcsf, list, n, x, out); \
+	}
+	KERNEL_MATCH_IF(cond_dummy_match, kernel_match_dummy)
+	KERNEL_MATCH_IF(cond_rectangle_match, kernel_match_rectangle)
+	KERNEL_MATCH_IF(cond_ellipsoid_match, kernel_match_ellipsoid)
+	KERNEL_MATCH_IF(cond_neural_match, kernel_match_neural)
+	KERNEL_MATCH_IF(cond_gp_match, kernel_match_gp)
+	KERNEL_MATCH_IF(cond_dgp_match, kernel_match_dgp)
+	KERNEL_MATCH_IF(cond_ternary_match, kernel_match_ternary)
+	KERNEL_MATCH_IF(cond_quantized_match, kernel_match_quantized)
+	KERNEL_MATCH_IF(rule_dgp_cond_match, kernel_match_rule_dgp)
+	KERNEL_MATCH_IF(rule_neural_cond_match, kernel_match_rule_neural)
+#undef KERNEL_MATCH_IF
+	return kernel_match_cl(xcsf, list, n, x, out);
+}
+
+void kernel_pred(XCSF *xcsf, CL **list, int n, double *x, double **pre)
+{
+	// computes the predictions of list with the loop of the population's
+	// prediction type
+	if(n == 0) {
+		return;
+	}
+#define KERNEL_PRED_IF(f, loop) \
+	if(KERNEL_PRED_FN(xcsf, f, pred_impl_compute)) { \
+		loop(xcsf, list, n, x, pre); \
+		return; \
+	}
+	KERNEL_PRED_IF(pred_nlms_compute, kernel_pred_nlms)
+	KERNEL_PRED_IF(pred_rls_compute, kernel_pred_rls)
+	KERNEL_PRED_IF(pred_neural_compute, kernel_pred_neural)
+	KERNEL_PRED_IF(rule_dgp_pred_compute, kernel_pred_rule_dgp)
+	KERNEL_PRED_IF(rule_neural_pred_compute, kernel_pred_rule_neural)
+#undef KERNEL_PRED_IF
+	kernel_pred_cl(xcsf, list, n, x, pre);
+}
+
+void kernel_update(XCSF *xcsf, CL **list, int n, double *x, double *y, double *mse)
+{
+	// updates list with the loop of the population's prediction type
+	if(n == 0) {
+		return;
+	}
+#define KERNEL_UPDATE_IF(p, f, loop) \
+	if(KERNEL_PRED_FN(xcsf, p, pred_impl_pre) \
+			&& KERNEL_PRED_FN(xcsf, f, pred_impl_update)) { \
+		loop(xcsf, list, n, x, y, mse); \
+		return; \
+	}
+	KERNEL_UPDATE_IF(pred_nlms_pre, pred_nlms_update, kernel_update_nlms)
+	KERNEL_UPDATE_IF(pred_rls_pre, pred_rls_update, kernel_update_rls)
+	KERNEL_UPDATE_IF(pred_neural_pre, pred_neural_update, kernel_update_neural)
+	KERNEL_UPDATE_IF(rule_dgp_pred_pre, rule_dgp_pred_update, kernel_update_rule_dgp)
+	KERNEL_UPDATE_IF(rule_neural_pred_pre, rule_neural_pred_update, kernel_update_rule_neural)
+#undef KERNEL_UPDATE_IF
+	for(int i = 0; i < n; i++) {
+		mse[i] = cl_update(xcsf, list[i], x, y);
+	}
+}
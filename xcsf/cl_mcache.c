@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2019 Richard Preen <rpreen@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **************
+ * Description:
+ **************
+ * The match cache module.
+ *
+ * Records, for each training input, the population classifiers that matched
+ * it so that revisiting the input evaluates only the conditions added since.
+ * Population conditions are never modified in place: mutation and crossover
+ * act on offspring before they are added. A recorded classifier therefore
+ * remains valid while it stays in the population, which is checked through
+ * the identifier assigned each time a classifier is added; classifiers
+ * removed are dropped lazily when their input is next visited. Classifiers
+ * added are appended to an insertion log and each input remembers how much
+ * of the log it has seen. When the log is full the cache is cleared.
+ *
+ * The memory used by the recorded classifiers is capped at MATCH_CACHE_BYTES
+ * by evicting inputs with the CLOCK policy: a hand sweeps the inputs, giving
+ * those used since it last passed a second chance.
+ *
+ * The cache lives for a single fit, during which no classifier is freed, so
+ * the recorded pointers are never left dangling. It is not used by conditions
+ * whose matching also computes predictions, COND_TYPE 11 and 12, nor with
+ * envelopes, THETA_ENV, since these change whether a condition matches.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "data_structures.h"
+#include "cl.h"
+#include "cl_set.h"
+#include "cl_mcache.h"
+
+#define MCACHE_MIN_LOG 1024 // minimum classifiers logged before clearing
+
+void mcache_clear(MCACHE *m);
+void mcache_evict(MCACHE *m, size_t limit);
+void mcache_row_free(MCACHE *m, MC_ROW *r);
+
+void mcache_init(XCSF *xcsf, double *x, int rows)
+{
+	// enables the cache over the training inputs stored contiguously at x
+	MCACHE *m = &xcsf->mcache;
+	m->x = NULL;
+	m->rows = 0;
+	m->row = NULL;
+	m->log = NULL;
+	m->log_size = 0;
+	m->log_capacity = 0;
+	m->bytes = 0;
+	m->hand = 0;
+	if(xcsf->MATCH_CACHE_BYTES == 0 || xcsf->THETA_ENV > 0
+			|| xcsf->COND_TYPE == 11 || xcsf->COND_TYPE == 12 || rows < 1) {
+		return;
+	}
+	m->x = x;
+	m->rows = rows;
+	m->row = calloc(rows, sizeof(MC_ROW));
+	m->log_capacity = xcsf->POP_SIZE * 4 > MCACHE_MIN_LOG ?
+		xcsf->POP_SIZE * 4 : MCACHE_MIN_LOG;
+	m->log = malloc(sizeof(MC_ITEM) * m->log_capacity);
+}
+
+void mcache_free(XCSF *xcsf)
+{
+	MCACHE *m = &xcsf->mcache;
+	if(m->x != NULL) {
+		mcache_clear(m);
+		free(m->row);
+		free(m->log);
+	}
+	m->x = NULL;
+	m->row = NULL;
+	m->log = NULL;
+}
+
+void mcache_add(XCSF *xcsf, CL *c)
+{
+	// logs a classifier just added to the population
+	MCACHE *m = &xcsf->mcache;
+	if(m->x == NULL) {
+		return;
+	}
+	if(m->log_size == m->log_capacity) {
+		mcache_clear(m);
+	}
+	m->log[m->log_size].c = c;
+	m->log[m->log_size].id = c->id;
+	m->log_size++;
+}
+
+_Bool mcache_match(XCSF *xcsf, double *x, SET *set)
+{
+	// adds the population classifiers matching a cached training input to the
+	// set, in no particular order; returns false if x is not cached
+	MCACHE *m = &xcsf->mcache;
+	int i = cl_input_row(xcsf, m->x, m->rows, x);
+	if(i < 0 || m->row[i].item == NULL) {
+		return false;
+	}
+	MC_ROW *r = &m->row[i];
+	r->ref = true;
+	for(int j = 0; j < r->size; j++) {
+		MC_ITEM *it = &r->item[j];
+		if(it->c->pos >= 0 && it->c->id == it->id) {
+			set_add(xcsf, set, it->c);
+		}
+	}
+	// evaluate the classifiers added since the input was last visited
+	for(int j = r->stamp; j < m->log_size; j++) {
+		MC_ITEM *it = &m->log[j];
+		if(it->c->pos >= 0 && it->c->id == it->id && cl_match(xcsf, it->c, x)) {
+			set_add(xcsf, set, it->c);
+		}
+	}
+	return true;
+}
+
+void mcache_store(XCSF *xcsf, double *x, SET *set)
+{
+	// records the classifiers of a complete match set for a training input
+	MCACHE *m = &xcsf->mcache;
+	int i = cl_input_row(xcsf, m->x, m->rows, x);
+	if(i < 0) {
+		return;
+	}
+	MC_ROW *r = &m->row[i];
+	if(r->capacity < set->size || r->item == NULL) {
+		int capacity = set->size > 4 ? set->size : 4;
+		m->bytes += sizeof(MC_ITEM) * (capacity - r->capacity);
+		r->item = realloc(r->item, sizeof(MC_ITEM) * capacity);
+		r->capacity = capacity;
+	}
+	for(int j = 0; j < set->size; j++) {
+		r->item[j].c = set->list[j];
+		r->item[j].id = set->list[j]->id;
+	}
+	r->size = set->size;
+	r->stamp = m->log_size;
+	r->ref = true;
+	mcache_evict(m, xcsf->MATCH_CACHE_BYTES);
+}
+
+void mcache_evict(MCACHE *m, size_t limit)
+{
+	// sweeps the inputs until the memory used is within the limit; every
+	// input loses its second chance within one revolution
+	while(m->bytes > limit) {
+		MC_ROW *r = &m->row[m->hand];
+		if(r->item != NULL) {
+			if(r->ref) {
+				r->ref = false;
+			}
+			else {
+				mcache_row_free(m, r);
+			}
+		}
+		m->hand = (m->hand + 1) % m->rows;
+	}
+}
+
+void mcache_row_free(MCACHE *m, MC_ROW *r)
+{
+	m->bytes -= sizeof(MC_ITEM) * r->capacity;
+	free(r->item);
+	r->item = NULL;
+	r->size = 0;
+	r->capacity = 0;
+	r->ref = false;
+}
+
+void mcache_clear(MCACHE *m)
+{
+	// forgets every input and empties the insertion log
+	for(int i = 0; i < m->rows; i++) {
+		if(m->row[i].item != NULL) {
+			mcache_row_free(m, &m->row[i]);
+		}
+	}
+	m->log_size = 0;
+	m->hand = 0;
+}
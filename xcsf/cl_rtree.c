@@ -0,0 +1,418 @@
+/*
+ * Copyright (C) 2019 Richard Preen <rpreen@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **************
+ * Description:
+ **************
+ * The classifier spatial index module.
+ *
+ * An R-tree that indexes classifiers by the axis-aligned bounding box of
+ * their condition so that the classifiers that may match an input can be
+ * found without testing the whole population. Insertion descends to the leaf
+ * whose box needs the least enlargement and overflowing nodes are divided
+ * with a quadratic split. Each indexed classifier records its leaf so that it
+ * is removed without searching; underfull nodes are then dissolved and their
+ * classifiers reinserted.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "data_structures.h"
+#include "cl.h"
+#include "cl_set.h"
+#include "cl_rtree.h"
+
+#define RT_MAX 8 // maximum number of entries in a node
+#define RT_MIN 3 // minimum number of entries in a non-root node
+
+typedef struct RT_NODE {
+	struct RT_NODE *parent;
+	_Bool leaf; // whether the entries are classifiers rather than nodes
+	int n; // number of entries
+	double *lower; // lower bounds of each entry's box
+	double *upper; // upper bounds of each entry's box
+	void *child[RT_MAX + 1]; // one spare entry is used while splitting
+} RT_NODE;
+
+RT_NODE *rt_node_new(RTREE *t, _Bool leaf);
+RT_NODE *rt_split(RTREE *t, RT_NODE *node);
+double rt_enlargement(int dim, double *l, double *u, double *el, double *eu);
+double rt_volume(int dim, double *l, double *u);
+int rt_slot(RT_NODE *node, void *child);
+void rt_add_entry(RTREE *t, RT_NODE *node, void *child, double *l, double *u);
+void rt_collect(XCSF *xcsf, RT_NODE *node, SET *set);
+void rt_cover(RTREE *t, RT_NODE *node, double *l, double *u);
+void rt_free_node(RT_NODE *node);
+void rt_insert(RTREE *t, CL *c, double *l, double *u);
+void rt_remove_entry(RTREE *t, RT_NODE *node, int i);
+void rt_search(XCSF *xcsf, RTREE *t, RT_NODE *node, double *x, SET *set);
+void rt_set_entry(RTREE *t, RT_NODE *node, int i, void *child, double *l, double *u);
+void rt_union(int dim, double *l, double *u, double *el, double *eu);
+
+void rtree_init(RTREE *t)
+{
+	t->root = NULL;
+	t->dim = 0;
+	t->size = 0;
+}
+
+void rtree_free(RTREE *t)
+{
+	if(t->root != NULL) {
+		rt_free_node(t->root);
+	}
+	rtree_init(t);
+}
+
+_Bool rtree_add(XCSF *xcsf, RTREE *t, CL *c)
+{
+	// indexes a classifier if its condition has a bounding box; its
+	// condition must not change while indexed
+	double l[xcsf->num_x_vars], u[xcsf->num_x_vars];
+	if(!cond_box(xcsf, c, l, u)) {
+		c->leaf = NULL;
+		return false;
+	}
+	if(t->root == NULL) {
+		t->dim = xcsf->num_x_vars;
+		t->root = rt_node_new(t, true);
+	}
+	rt_insert(t, c, l, u);
+	t->size++;
+	return true;
+}
+
+void rtree_remove(XCSF *xcsf, RTREE *t, CL *c)
+{
+	if(c->leaf == NULL) {
+		return;
+	}
+	RT_NODE *node = c->leaf;
+	rt_remove_entry(t, node, rt_slot(node, c));
+	c->leaf = NULL;
+	t->size--;
+	// dissolve underfull nodes on the path to the root and shrink the rest
+	SET orphans;
+	set_init(xcsf, &orphans);
+	while(node != t->root) {
+		RT_NODE *parent = node->parent;
+		int i = rt_slot(parent, node);
+		if(node->n < RT_MIN) {
+			rt_remove_entry(t, parent, i);
+			rt_collect(xcsf, node, &orphans);
+		}
+		else {
+			rt_cover(t, node, &parent->lower[i * t->dim], &parent->upper[i * t->dim]);
+		}
+		node = parent;
+	}
+	while(!t->root->leaf && t->root->n == 1) {
+		RT_NODE *root = t->root;
+		t->root = root->child[0];
+		t->root->parent = NULL;
+		free(root);
+	}
+	// reinsert the classifiers of dissolved nodes
+	double l[t->dim], u[t->dim];
+	for(int i = 0; i < orphans.size; i++) {
+		cond_box(xcsf, orphans.list[i], l, u);
+		rt_insert(t, orphans.list[i], l, u);
+	}
+	set_free(xcsf, &orphans);
+}
+
+void rtree_match(XCSF *xcsf, RTREE *t, double *x, SET *set)
+{
+	// adds the indexed classifiers that match x to the set
+	if(t->root != NULL) {
+		rt_search(xcsf, t, t->root, x, set);
+	}
+}
+
+void rt_search(XCSF *xcsf, RTREE *t, RT_NODE *node, double *x, SET *set)
+{
+	for(int i = 0; i < node->n; i++) {
+		double *l = &node->lower[i * t->dim];
+		double *u = &node->upper[i * t->dim];
+		int j = 0;
+		while(j < t->dim && l[j] <= x[j] && u[j] >= x[j]) {
+			j++;
+		}
+		if(j < t->dim) {
+			continue;
+		}
+		if(node->leaf) {
+			CL *c = node->child[i];
+			if(cl_match(xcsf, c, x)) {
+				set_add(xcsf, set, c);
+			}
+		}
+		else {
+			rt_search(xcsf, t, node->child[i], x, set);
+		}
+	}
+}
+
+void rt_insert(RTREE *t, CL *c, double *l, double *u)
+{
+	// descends to the leaf needing the least enlargement, preferring the
+	// smaller box on ties
+	RT_NODE *node = t->root;
+	while(!node->leaf) {
+		int best = 0;
+		double best_enl = 0.0;
+		double best_vol = 0.0;
+		for(int i = 0; i < node->n; i++) {
+			double *nl = &node->lower[i * t->dim];
+			double *nu = &node->upper[i * t->dim];
+			double enl = rt_enlargement(t->dim, nl, nu, l, u);
+			double vol = rt_volume(t->dim, nl, nu);
+			if(i == 0 || enl < best_enl || (enl == best_enl && vol < best_vol)) {
+				best = i;
+				best_enl = enl;
+				best_vol = vol;
+			}
+		}
+		rt_union(t->dim, &node->lower[best * t->dim], &node->upper[best * t->dim], l, u);
+		node = node->child[best];
+	}
+	rt_add_entry(t, node, c, l, u);
+	// split overflowing nodes towards the root
+	while(node->n > RT_MAX) {
+		RT_NODE *sibling = rt_split(t, node);
+		if(node == t->root) {
+			RT_NODE *root = rt_node_new(t, false);
+			double rl[t->dim], ru[t->dim];
+			rt_cover(t, node, rl, ru);
+			rt_add_entry(t, root, node, rl, ru);
+			t->root = root;
+		}
+		RT_NODE *parent = node->parent;
+		double sl[t->dim], su[t->dim];
+		int i = rt_slot(parent, node);
+		rt_cover(t, node, &parent->lower[i * t->dim], &parent->upper[i * t->dim]);
+		rt_cover(t, sibling, sl, su);
+		rt_add_entry(t, parent, sibling, sl, su);
+		node = parent;
+	}
+}
+
+RT_NODE *rt_split(RTREE *t, RT_NODE *node)
+{
+	// divides the entries of an overflowing node between it and a new
+	// sibling using Guttman's quadratic split
+	int dim = t->dim;
+	int n = node->n;
+	double lower[n * dim], upper[n * dim];
+	void *child[n];
+	memcpy(lower, node->lower, sizeof(double) * n * dim);
+	memcpy(upper, node->upper, sizeof(double) * n * dim);
+	memcpy(child, node->child, sizeof(void*) * n);
+	// seed each group with the pair of entries that would waste most volume
+	int s1 = 0, s2 = 1;
+	double worst = 0.0;
+	for(int i = 0; i < n; i++) {
+		for(int j = i + 1; j < n; j++) {
+			double waste = rt_enlargement(dim, &lower[i * dim], &upper[i * dim],
+					&lower[j * dim], &upper[j * dim]) -
+				rt_volume(dim, &lower[j * dim], &upper[j * dim]);
+			if((i == 0 && j == 1) || waste > worst) {
+				s1 = i;
+				s2 = j;
+				worst = waste;
+			}
+		}
+	}
+	RT_NODE *sibling = rt_node_new(t, node->leaf);
+	sibling->parent = node->parent;
+	node->n = 0;
+	_Bool assigned[n];
+	memset(assigned, 0, sizeof(assigned));
+	assigned[s1] = assigned[s2] = true;
+	rt_add_entry(t, node, child[s1], &lower[s1 * dim], &upper[s1 * dim]);
+	rt_add_entry(t, sibling, child[s2], &lower[s2 * dim], &upper[s2 * dim]);
+	double l1[dim], u1[dim], l2[dim], u2[dim];
+	memcpy(l1, &lower[s1 * dim], sizeof(double) * dim);
+	memcpy(u1, &upper[s1 * dim], sizeof(double) * dim);
+	memcpy(l2, &lower[s2 * dim], sizeof(double) * dim);
+	memcpy(u2, &upper[s2 * dim], sizeof(double) * dim);
+	for(int remaining = n - 2; remaining > 0; remaining--) {
+		// assign the entry with the strongest preference for one group,
+		// unless a group needs all the remaining entries to reach RT_MIN
+		int next = -1;
+		_Bool first = false;
+		double most = -1.0;
+		for(int i = 0; i < n; i++) {
+			if(assigned[i]) {
+				continue;
+			}
+			double d1 = rt_enlargement(dim, l1, u1, &lower[i * dim], &upper[i * dim]);
+			double d2 = rt_enlargement(dim, l2, u2, &lower[i * dim], &upper[i * dim]);
+			double diff = d1 > d2 ? d1 - d2 : d2 - d1;
+			if(diff > most) {
+				next = i;
+				most = diff;
+				if(d1 != d2) {
+					first = d1 < d2;
+				}
+				else if(rt_volume(dim, l1, u1) != rt_volume(dim, l2, u2)) {
+					first = rt_volume(dim, l1, u1) < rt_volume(dim, l2, u2);
+				}
+				else {
+					first = node->n <= sibling->n;
+				}
+			}
+		}
+		if(node->n + remaining <= RT_MIN) {
+			first = true;
+		}
+		else if(sibling->n + remaining <= RT_MIN) {
+			first = false;
+		}
+		assigned[next] = true;
+		if(first) {
+			rt_add_entry(t, node, child[next], &lower[next * dim], &upper[next * dim]);
+			rt_union(dim, l1, u1, &lower[next * dim], &upper[next * dim]);
+		}
+		else {
+			rt_add_entry(t, sibling, child[next], &lower[next * dim], &upper[next * dim]);
+			rt_union(dim, l2, u2, &lower[next * dim], &upper[next * dim]);
+		}
+	}
+	return sibling;
+}
+
+RT_NODE *rt_node_new(RTREE *t, _Bool leaf)
+{
+	// the entry boxes are stored after the node in a single block
+	size_t bytes = sizeof(double) * (RT_MAX + 1) * t->dim;
+	RT_NODE *node = malloc(sizeof(RT_NODE) + 2 * bytes);
+	node->parent = NULL;
+	node->leaf = leaf;
+	node->n = 0;
+	node->lower = (double *) (node + 1);
+	node->upper = node->lower + (RT_MAX + 1) * t->dim;
+	return node;
+}
+
+void rt_free_node(RT_NODE *node)
+{
+	if(!node->leaf) {
+		for(int i = 0; i < node->n; i++) {
+			rt_free_node(node->child[i]);
+		}
+	}
+	free(node);
+}
+
+void rt_collect(XCSF *xcsf, RT_NODE *node, SET *set)
+{
+	// gathers the classifiers below a node into the set and frees the nodes
+	for(int i = 0; i < node->n; i++) {
+		if(node->leaf) {
+			set_add(xcsf, set, node->child[i]);
+		}
+		else {
+			rt_collect(xcsf, node->child[i], set);
+		}
+	}
+	free(node);
+}
+
+void rt_set_entry(RTREE *t, RT_NODE *node, int i, void *child, double *l, double *u)
+{
+	memmove(&node->lower[i * t->dim], l, sizeof(double) * t->dim);
+	memmove(&node->upper[i * t->dim], u, sizeof(double) * t->dim);
+	node->child[i] = child;
+	if(node->leaf) {
+		((CL *) child)->leaf = node;
+	}
+	else {
+		((RT_NODE *) child)->parent = node;
+	}
+}
+
+void rt_add_entry(RTREE *t, RT_NODE *node, void *child, double *l, double *u)
+{
+	rt_set_entry(t, node, node->n, child, l, u);
+	node->n++;
+}
+
+void rt_remove_entry(RTREE *t, RT_NODE *node, int i)
+{
+	// removes the i-th entry by moving the last one into its place
+	node->n--;
+	if(i != node->n) {
+		int last = node->n;
+		rt_set_entry(t, node, i, node->child[last],
+				&node->lower[last * t->dim], &node->upper[last * t->dim]);
+	}
+}
+
+int rt_slot(RT_NODE *node, void *child)
+{
+	int i = 0;
+	while(node->child[i] != child) {
+		i++;
+	}
+	return i;
+}
+
+void rt_cover(RTREE *t, RT_NODE *node, double *l, double *u)
+{
+	// the smallest box enclosing all of a node's entries
+	memcpy(l, node->lower, sizeof(double) * t->dim);
+	memcpy(u, node->upper, sizeof(double) * t->dim);
+	for(int i = 1; i < node->n; i++) {
+		rt_union(t->dim, l, u, &node->lower[i * t->dim], &node->upper[i * t->dim]);
+	}
+}
+
+void rt_union(int dim, double *l, double *u, double *el, double *eu)
+{
+	// grows the box l, u to enclose the box el, eu
+	for(int j = 0; j < dim; j++) {
+		if(el[j] < l[j]) {
+			l[j] = el[j];
+		}
+		if(eu[j] > u[j]) {
+			u[j] = eu[j];
+		}
+	}
+}
+
+double rt_volume(int dim, double *l, double *u)
+{
+	double vol = 1.0;
+	for(int j = 0; j < dim; j++) {
+		vol *= u[j] - l[j];
+	}
+	return vol;
+}
+
+double rt_enlargement(int dim, double *l, double *u, double *el, double *eu)
+{
+	// the increase in volume of the box l, u needed to enclose el, eu
+	double vol = 1.0;
+	for(int j = 0; j < dim; j++) {
+		double lo = el[j] < l[j] ? el[j] : l[j];
+		double hi = eu[j] > u[j] ? eu[j] : u[j];
+		vol *= hi - lo;
+	}
+	return vol - rt_volume(dim, l, u);
+}
@@ -32,234 +32,569 @@
 #include "random.h"
 #include "cl.h"
 #include "cl_set.h"
+#include "sum_tree.h"
+#include "pool.h"
+#include "cl_index.h"
+#include "cl_rtree.h"
+#include "cl_boxes.h"
+#include "cl_mcache.h"
+#include "cl_kernel.h"
+#ifdef PARALLEL_MATCH
+#include <omp.h>
+#endif
+
+#define SET_MIN_CAPACITY 16 // initial length of a set list
+#define DEL_AVG_MARGIN 1.1 // headroom above the mean fitness for vote bounds
 
-void set_subsumption(XCSF *xcsf, NODE **set, int *size, int *num, NODE **kset);
-void set_update_fit(XCSF *xcsf, NODE **set, int size, int num_sum);
+double pop_vote_bound(XCSF *xcsf, CL *c);
+void pop_del_rebuild(XCSF *xcsf, double avg_fit);
+_Bool pop_over_budget(XCSF *xcsf);
+int set_cmp_pos(const void *a, const void *b);
+void set_match_scan(XCSF *xcsf, SET *mset, double *x);
+void pop_sam_add(XCSF *xcsf, CL *c, double sign);
+_Bool pop_vptr_other(XCSF *xcsf, CL *c);
+void pop_vptr_recount(XCSF *xcsf);
+void set_subsumption(XCSF *xcsf, SET *mset, SET *kset);
+void set_update_err(XCSF *xcsf, int n, double *err, double *exp, double *mse);
+void set_update_fit(XCSF *xcsf, int n, double *fit, double *err, double *num, int set_num);
+void set_update_size(XCSF *xcsf, int n, double *size, double *exp, int set_num);
 
 void pop_init(XCSF *xcsf)
 {
-    // initialise population
-    xcsf->pset = NULL; // population linked list
-    xcsf->pop_num = 0; // num macro-classifiers
-    xcsf->pop_num_sum = 0; // numerosity sum
+    // initialise an empty population and the sets used by each trial
+    set_init(xcsf, &xcsf->pset);
+    set_init(xcsf, &xcsf->mset);
+    set_init(xcsf, &xcsf->kset);
+    pool_init(xcsf);
+    sum_tree_init(&xcsf->del_tree);
+    sum_tree_init(&xcsf->fit_tree);
+    cl_index_init(&xcsf->pop_index);
+    rtree_init(&xcsf->pop_rtree);
+    boxes_init(&xcsf->pop_boxes);
+    xcsf->pop_cond_vptr = NULL;
+    xcsf->pop_pred_vptr = NULL;
+    xcsf->pop_mixed = 0;
+    xcsf->pop_bytes = 0;
+    xcsf->next_id = 0;
+    mcache_init(xcsf, NULL, 0);
+    xcsf->sig_x = NULL;
+    xcsf->sig_rows = 0;
+    xcsf->sig_epoch = 0;
+    xcsf->env_rejects = 0;
+    xcsf->env_passes = 0;
+    xcsf->covers = 0;
+    xcsf->cover_tries = 0;
+    xcsf->cover_built = 0;
+    xcsf->qx = NULL;
+    xcsf->qx_size = 0;
+    xcsf->qx_src = NULL;
+    xcsf->tx = NULL;
+    xcsf->tx_size = 0;
+    xcsf->tx_src = NULL;
+    xcsf->x_span = NULL;
+    xcsf->del_avg_fit = 0.0;
+    xcsf->mu_sum = NULL;
+    xcsf->mu_len = 0;
     xcsf->time = 0; // number of learning trials performed
+}
 
+void pop_init_rand(XCSF *xcsf)
+{
+    // fill the population with random classifiers if enabled
     if(xcsf->POP_INIT) {
-        while(xcsf->pop_num_sum < xcsf->POP_SIZE) {
-            CL *new = malloc(sizeof(CL));
-            cl_init(xcsf, new, xcsf->POP_SIZE, 0);
+        while(xcsf->pset.num < xcsf->POP_SIZE && !pop_over_budget(xcsf)) {
+            CL *new = pool_get(xcsf, xcsf->POP_SIZE, 0);
             cl_rand(xcsf, new);
             pop_add(xcsf, new);
         }
     }
 }
 
+void pop_free(XCSF *xcsf)
+{
+    // frees the population set, its classifiers, the trial sets, the pool,
+    // and the population sums
+    mcache_free(xcsf);
+    set_kill(xcsf, &xcsf->pset);
+    set_free(xcsf, &xcsf->mset);
+    set_kill(xcsf, &xcsf->kset);
+    pool_free(xcsf);
+    sum_tree_free(&xcsf->del_tree);
+    sum_tree_free(&xcsf->fit_tree);
+    cl_index_free(&xcsf->pop_index);
+    rtree_free(&xcsf->pop_rtree);
+    boxes_free(&xcsf->pop_boxes);
+    free(xcsf->mu_sum);
+    xcsf->mu_sum = NULL;
+    xcsf->mu_len = 0;
+    free(xcsf->sig_x);
+    xcsf->sig_x = NULL;
+    xcsf->sig_rows = 0;
+    free(xcsf->qx);
+    xcsf->qx = NULL;
+    xcsf->qx_size = 0;
+    xcsf->qx_src = NULL;
+    free(xcsf->tx);
+    xcsf->tx = NULL;
+    xcsf->tx_size = 0;
+    xcsf->tx_src = NULL;
+    xcsf->x_span = NULL;
+}
+
 void pop_add(XCSF *xcsf, CL *c)
 {
     // adds a classifier to the population set
-    xcsf->pop_num_sum++;
-    xcsf->pop_num++;
-    if(xcsf->pset == NULL) {
-        xcsf->pset = malloc(sizeof(NODE));
-        xcsf->pset->cl = c;
-        xcsf->pset->next = NULL;
+    if(xcsf->pset.size == 0) {
+        xcsf->mu_sum = realloc(xcsf->mu_sum, sizeof(double) * xcsf->NUM_SAM);
+        xcsf->mu_len = xcsf->NUM_SAM;
+        for(int i = 0; i < xcsf->mu_len; i++) {
+            xcsf->mu_sum[i] = 0.0;
+        }
+        xcsf->pop_cond_vptr = c->cond_vptr;
+        xcsf->pop_pred_vptr = c->pred_vptr;
+        xcsf->pop_mixed = 0;
     }
-    else {
-        NODE *new = malloc(sizeof(NODE));
-        new->next = xcsf->pset;
-        new->cl = c;
-        xcsf->pset = new;
+    // NUM_SAM may have changed since earlier classifiers were created; only
+    // the rates that every classifier has are summed
+    if(xcsf->NUM_SAM < xcsf->mu_len) {
+        xcsf->mu_len = xcsf->NUM_SAM;
     }
+    // the types may have changed since earlier classifiers were created
+    xcsf->pop_mixed += pop_vptr_other(xcsf, c);
+    c->pos = xcsf->pset.size;
+    c->id = xcsf->next_id++;
+    c->mem = cl_mem(xcsf, c);
+    xcsf->pop_bytes += c->mem;
+    set_add(xcsf, &xcsf->pset, c);
+    pop_update_cl(xcsf, c);
+    pop_sam_add(xcsf, c, 1.0);
+    // index by condition hash, and by bounding box for matching
+    cl_index_add(xcsf, &xcsf->pop_index, c);
+#ifdef SIMD_MATCH
+    boxes_add(xcsf, &xcsf->pop_boxes, c);
+#else
+    rtree_add(xcsf, &xcsf->pop_rtree, c);
+#endif
+    mcache_add(xcsf, c);
 }
 
-void pop_del(XCSF *xcsf, NODE **kset)
+CL *pop_find(XCSF *xcsf, CL *c)
+{
+    // returns a population classifier with a condition identical to c's
+    return cl_index_find(xcsf, &xcsf->pop_index, c);
+}
+
+void pop_sam_add(XCSF *xcsf, CL *c, double sign)
+{
+    // adds (or subtracts) a classifier's mutation rates to the population
+    // sums; rates only adapt before a classifier is inserted
+    for(int i = 0; i < xcsf->mu_len; i++) {
+        xcsf->mu_sum[i] += sign * cl_mutation_rate(xcsf, c, i);
+    }
+}
+
+double pop_avg_mu(XCSF *xcsf, int m)
+{
+    // returns the mean of a mutation rate over the macro-classifiers
+    if(xcsf->pset.size == 0 || m >= xcsf->mu_len) {
+        return 0.0;
+    }
+    return xcsf->mu_sum[m] / xcsf->pset.size;
+}
+
+double pop_total_fit(XCSF *xcsf)
+{
+    return sum_tree_total(&xcsf->fit_tree);
+}
+
+void pop_env_counts(XCSF *xcsf, long *rejects, long *passes)
+{
+    // returns the number of inputs rejected by classifier envelopes without
+    // evaluating the condition, and the number passed on to the condition
+    *rejects = xcsf->env_rejects;
+    *passes = xcsf->env_passes;
+    for(int i = 0; i < xcsf->pset.size; i++) {
+        *rejects += xcsf->pset.list[i]->env_rejects;
+        *passes += xcsf->pset.list[i]->env_passes;
+    }
+}
+
+void pop_update_cl(XCSF *xcsf, CL *c)
+{
+    // refreshes the population sums after a change to a classifier's
+    // fitness, numerosity, experience, or set size estimate
+    sum_tree_set(&xcsf->fit_tree, c->pos, c->fit);
+    sum_tree_set(&xcsf->del_tree, c->pos, pop_vote_bound(xcsf, c));
+}
+
+void pop_remove(XCSF *xcsf, CL *c)
+{
+    // removes a classifier from the population by moving the last one into
+    // its place
+    SET *pset = &xcsf->pset;
+    int i = c->pos;
+    int last = pset->size - 1;
+    pop_sam_add(xcsf, c, -1.0);
+    xcsf->pop_mixed -= pop_vptr_other(xcsf, c);
+    cl_index_remove(&xcsf->pop_index, c);
+#ifdef SIMD_MATCH
+    boxes_remove(xcsf, &xcsf->pop_boxes, c);
+#else
+    rtree_remove(xcsf, &xcsf->pop_rtree, c);
+#endif
+    xcsf->pop_bytes -= c->mem;
+    xcsf->env_rejects += c->env_rejects;
+    xcsf->env_passes += c->env_passes;
+    set_remove(xcsf, pset, i);
+    if(i != last) {
+        pset->list[i]->pos = i;
+        sum_tree_set(&xcsf->fit_tree, i, sum_tree_get(&xcsf->fit_tree, last));
+        sum_tree_set(&xcsf->del_tree, i, sum_tree_get(&xcsf->del_tree, last));
+    }
+    sum_tree_set(&xcsf->fit_tree, last, 0.0);
+    sum_tree_set(&xcsf->del_tree, last, 0.0);
+    c->pos = -1;
+    if(xcsf->pop_mixed > 0 && xcsf->pop_mixed == pset->size) {
+        pop_vptr_recount(xcsf);
+    }
+#ifdef SIMD_MATCH
+    // boxes may be available again once the population has a single type
+    if(xcsf->pop_mixed == 0 && !xcsf->pop_boxes.valid && pset->size > 0) {
+        boxes_rebuild(xcsf, &xcsf->pop_boxes);
+    }
+#endif
+}
+
+_Bool pop_vptr_other(XCSF *xcsf, CL *c)
+{
+    // whether a classifier uses other functions than the population's
+    return c->cond_vptr != xcsf->pop_cond_vptr || c->pred_vptr != xcsf->pop_pred_vptr;
+}
+
+void pop_vptr_recount(XCSF *xcsf)
+{
+    // adopts the functions of the first classifier once none remain with the
+    // previous ones, so that a population of a new type is uniform again
+    SET *pset = &xcsf->pset;
+    xcsf->pop_cond_vptr = pset->list[0]->cond_vptr;
+    xcsf->pop_pred_vptr = pset->list[0]->pred_vptr;
+    xcsf->pop_mixed = 0;
+    for(int i = 1; i < pset->size; i++) {
+        xcsf->pop_mixed += pop_vptr_other(xcsf, pset->list[i]);
+    }
+}
+
+double pop_vote_bound(XCSF *xcsf, CL *c)
+{
+    // the deletion vote for any mean fitness up to del_avg_fit is no greater
+    return fmax(c->size * c->num * cl_del_mem(xcsf, c),
+            cl_del_vote(xcsf, c, xcsf->del_avg_fit));
+}
+
+void pop_del_rebuild(XCSF *xcsf, double avg_fit)
+{
+    // recalculates the deletion vote bounds for a new mean fitness bound
+    xcsf->del_avg_fit = avg_fit;
+    for(int i = 0; i < xcsf->pset.size; i++) {
+        sum_tree_set(&xcsf->del_tree, i, pop_vote_bound(xcsf, xcsf->pset.list[i]));
+    }
+}
+
+void pop_del(XCSF *xcsf, SET *kset)
 {
     // selects a classifier using roullete wheel selection with the deletion 
     // vote; sets its numerosity to zero, and removes it from the population 
+    SET *pset = &xcsf->pset;
+    double avg_fit = pop_total_fit(xcsf) / pset->num;
+    if(avg_fit > xcsf->del_avg_fit
+            || avg_fit * DEL_AVG_MARGIN * DEL_AVG_MARGIN < xcsf->del_avg_fit) {
+        pop_del_rebuild(xcsf, avg_fit * DEL_AVG_MARGIN);
+    }
 
-    // select a roullete point
-    double avg_fit = set_total_fit(xcsf, &xcsf->pset) / xcsf->pop_num_sum;
-    double sum = 0.0;
-    for(NODE *iter = xcsf->pset; iter != NULL; iter = iter->next) {
-        sum += cl_del_vote(xcsf, iter->cl, avg_fit);
-    }
-    double p = drand() * sum;
-
-    // find the classifier to delete using the point
-    sum = 0.0;
-    NODE *prev = NULL;
-    for(NODE *iter = xcsf->pset; iter != NULL; iter = iter->next) {
-        sum += cl_del_vote(xcsf, iter->cl, avg_fit);
-        if(sum > p) {
-            iter->cl->num--;
-            xcsf->pop_num_sum--;
-            // macro classifier must be deleted
-            if(iter->cl->num == 0) {
-                set_add(xcsf, kset, iter->cl);
-                xcsf->pop_num--;
-                if(prev == NULL) {
-                    xcsf->pset = iter->next;
-                }
-                else {
-                    prev->next = iter->next;    
-                }
-                free(iter);
-            }
-            return;
-        }
-        prev = iter; 
-    }   
+    // draw from the vote bounds until a candidate is accepted with
+    // probability vote / bound, selecting each in proportion to its vote
+    CL *c = NULL;
+    double bound = 0.0;
+    do {
+        double p = drand() * sum_tree_total(&xcsf->del_tree);
+        int i = sum_tree_search(&xcsf->del_tree, p);
+        c = pset->list[i];
+        bound = sum_tree_get(&xcsf->del_tree, i);
+    } while(drand() * bound > cl_del_vote(xcsf, c, avg_fit));
+
+    c->num--;
+    pset->num--;
+    // macro classifier must be deleted
+    if(c->num == 0) {
+        set_add(xcsf, kset, c);
+        pop_remove(xcsf, c);
+    }
+    else {
+        pop_update_cl(xcsf, c);
+    }
 }
 
-void pop_enforce_limit(XCSF *xcsf, NODE **kset)
+_Bool pop_enforce_limit(XCSF *xcsf, SET *kset)
 {
-    while(xcsf->pop_num_sum > xcsf->POP_SIZE) {
+    // deletes classifiers until the population is within its size and
+    // memory limits; returns whether any numerosity was removed
+    _Bool deleted = false;
+    while(xcsf->pset.num > xcsf->POP_SIZE || pop_over_budget(xcsf)) {
         pop_del(xcsf, kset);
+        deleted = true;
     }
+    return deleted;
+}
+
+_Bool pop_over_budget(XCSF *xcsf)
+{
+    // whether the population exceeds its memory limit; at least one
+    // classifier is always retained
+    return xcsf->MAX_POP_BYTES > 0 && xcsf->pop_bytes > xcsf->MAX_POP_BYTES
+        && xcsf->pset.size > 1;
 }
 
-void set_match(XCSF *xcsf, NODE **set, int *size, int *num, double *x, NODE **kset)
+void set_match(XCSF *xcsf, SET *mset, double *x, SET *kset)
 {
     // add classifiers that match the input state to the match set  
-#ifdef PARALLEL_MATCH
-    NODE *blist[xcsf->pop_num];
-    int j = 0;
-    for(NODE *iter = xcsf->pset; iter != NULL; iter = iter->next) {
-        blist[j] = iter;
-        j++;
-    }
-    // update current matching conditions
-    int s = 0; int n = 0;
-#pragma omp parallel for reduction(+:s,n)
-    for(int i = 0; i < xcsf->pop_num; i++) {
-        if(cl_match(xcsf, blist[i]->cl, x)) {
-            s++;
-            n += blist[i]->cl->num;
-        }
+    cl_input(xcsf, x, 1);
+    int start = mset->size;
+    if(mcache_match(xcsf, x, mset)) {
+        // reuse the classifiers cached for a training input
+        qsort(mset->list + start, mset->size - start, sizeof(CL*), set_cmp_pos);
     }
-    *size = s; *num = n;
-    // build m list
-    for(int i = 0; i < xcsf->pop_num; i++) {
-        if(cl_match_state(xcsf, blist[i]->cl)) {
-            set_add(xcsf, set, blist[i]->cl);
-        }
+    else
+#ifdef SIMD_MATCH
+    if(xcsf->pop_boxes.valid && xcsf->pop_boxes.size > 0) {
+        // test blocks of bounding boxes at once
+        boxes_match(xcsf, &xcsf->pop_boxes, x, mset);
     }
-#else
-    for(NODE *iter = xcsf->pset; iter != NULL; iter = iter->next) {
-        if(cl_match(xcsf, iter->cl, x)) {
-            set_add(xcsf, set, iter->cl);
-            *num += iter->cl->num;
-            (*size)++;                    
-        }
-    }   
+    else
 #endif
+    if(xcsf->pop_rtree.size > 0 && xcsf->pop_rtree.size == xcsf->pset.size) {
+        // query the spatial index and restore the population order
+        rtree_match(xcsf, &xcsf->pop_rtree, x, mset);
+        qsort(mset->list + start, mset->size - start, sizeof(CL*), set_cmp_pos);
+    }
+    else {
+        set_match_scan(xcsf, mset, x);
+    }
     // perform covering if match set size is < THETA_MNA
-    while(*size < xcsf->THETA_MNA) {
+    while(mset->size < xcsf->THETA_MNA) {
         // new classifier with matching condition
-        CL *new = malloc(sizeof(CL));
-        cl_init(xcsf, new, *num+1, xcsf->time);
+        CL *new = pool_get(xcsf, mset->num+1, xcsf->time);
         cl_cover(xcsf, new, x);
-        (*size)++;
-        (*num)++;
         pop_add(xcsf, new);
-        set_add(xcsf, set, new); 
-        pop_enforce_limit(xcsf, kset);
+        set_add(xcsf, mset, new); 
         // remove any deleted classifiers from the match set
-        set_validate(xcsf, set, size, num);
+        if(pop_enforce_limit(xcsf, kset)) {
+            set_validate(xcsf, mset);
+        }
     }
+    mcache_store(xcsf, x, mset);
 }
 
-void set_pred(XCSF *xcsf, NODE **set, int size, double *x, double *y)
+void set_match_scan(XCSF *xcsf, SET *mset, double *x)
 {
-    // match set fitness weighted prediction
-    double *presum = calloc(xcsf->num_y_vars, sizeof(double));
-    double fitsum = 0.0;
-#ifdef PARALLEL_PRED
-    NODE *blist[size];
-    int j = 0;
-    for(NODE *iter = *set; iter != NULL; iter = iter->next) {
-        blist[j] = iter;
-        j++;
+    // tests every population classifier against the input state
+    SET *pset = &xcsf->pset;
+    int base = mset->size;
+    set_reserve(xcsf, mset, base + pset->size);
+#ifdef PARALLEL_MATCH
+    // each thread tests a contiguous slice of the population and writes its
+    // matching classifiers into the same slice of the match set list; the
+    // per-thread counts are then prefix summed to pack the matches in order
+    int max_threads = omp_get_max_threads();
+    int lo[max_threads], cnt[max_threads], num[max_threads];
+    for(int t = 0; t < max_threads; t++) {
+        cnt[t] = 0;
     }
-#pragma omp parallel for reduction(+:presum[:xcsf->num_y_vars],fitsum)
-    for(int i = 0; i < size; i++) {
-        double *predictions = cl_predict(xcsf, blist[i]->cl, x);
-        for(int var = 0; var < xcsf->num_y_vars; var++) {
-            presum[var] += predictions[var] * blist[i]->cl->fit;
+#pragma omp parallel
+    {
+        int t = omp_get_thread_num();
+        int n = omp_get_num_threads();
+        int start = (int) ((long) pset->size * t / n);
+        int end = (int) ((long) pset->size * (t + 1) / n);
+        CL **buf = mset->list + base + start;
+        int count = kernel_match(xcsf, pset->list + start, end - start, x, buf);
+        int sum = 0;
+        for(int i = 0; i < count; i++) {
+            sum += buf[i]->num;
+        }
+        lo[t] = start;
+        cnt[t] = count;
+        num[t] = sum;
+    }
+    for(int t = 0; t < max_threads; t++) {
+        if(cnt[t] > 0) {
+            memmove(mset->list + mset->size, mset->list + base + lo[t],
+                    sizeof(CL*) * cnt[t]);
+            mset->size += cnt[t];
+            mset->num += num[t];
         }
-        fitsum += blist[i]->cl->fit;
     }
 #else
-    (void)size; // remove unused parameter warnings
-    for(NODE *iter = *set; iter != NULL; iter = iter->next) {
-        double *predictions = cl_predict(xcsf, iter->cl, x);
+    int count = kernel_match(xcsf, pset->list, pset->size, x, mset->list + base);
+    for(int i = base; i < base + count; i++) {
+        mset->num += mset->list[i]->num;
+    }
+    mset->size += count;
+#endif
+}
+
+int set_cmp_pos(const void *a, const void *b)
+{
+    // orders classifiers by their position in the population set
+    return (*(CL * const *) a)->pos - (*(CL * const *) b)->pos;
+}
+
+void set_pred(XCSF *xcsf, SET *set, double *x, double *y)
+{
+    // match set fitness weighted prediction
+    double presum[xcsf->num_y_vars];
+    for(int var = 0; var < xcsf->num_y_vars; var++) {
+        presum[var] = 0.0;
+    }
+    double fitsum = 0.0;
+    double *predictions[set->size > 0 ? set->size : 1];
+    kernel_pred(xcsf, set->list, set->size, x, predictions);
+    for(int i = 0; i < set->size; i++) {
+        CL *c = set->list[i];
         for(int var = 0; var < xcsf->num_y_vars; var++) {
-            presum[var] += predictions[var] * iter->cl->fit;
+            presum[var] += predictions[i][var] * c->fit;
         }
-        fitsum += iter->cl->fit;
-    }    
-#endif
+        fitsum += c->fit;
+    }
     for(int var = 0; var < xcsf->num_y_vars; var++) {
         y[var] = presum[var]/fitsum;
     }
-    // clean up
-    free(presum);
 }
 
-void set_add(XCSF *xcsf, NODE **set, CL *c)
+void set_init(XCSF *xcsf, SET *set)
 {
-    // adds a classifier to the set
-    if(*set == NULL) {
-        *set = malloc(sizeof(NODE));
-        (*set)->cl = c;
-        (*set)->next = NULL;
-    }
-    else {
-        NODE *new = malloc(sizeof(NODE));
-        new->cl = c;
-        new->next = *set;
-        *set = new;
+    // initialises an empty set
+    set->list = NULL;
+    set->size = 0;
+    set->num = 0;
+    set->capacity = 0;
+    (void)xcsf;
+}
+
+void set_add(XCSF *xcsf, SET *set, CL *c)
+{
+    // adds a classifier to the end of the set
+    set_reserve(xcsf, set, set->size + 1);
+    set->list[set->size] = c;
+    set->size++;
+    set->num += c->num;
+}
+
+void set_reserve(XCSF *xcsf, SET *set, int n)
+{
+    // grows the set list geometrically until it can hold n classifiers
+    if(n > set->capacity) {
+        if(set->capacity < SET_MIN_CAPACITY) {
+            set->capacity = SET_MIN_CAPACITY;
+        }
+        while(set->capacity < n) {
+            set->capacity *= 2;
+        }
+        set->list = realloc(set->list, sizeof(CL*) * set->capacity);
     }
     (void)xcsf;
 }
 
-void set_update(XCSF *xcsf, NODE **set, int *size, int *num, double *x, double *y, NODE **kset)
+void set_clear(XCSF *xcsf, SET *set)
+{
+    // empties the set, keeping its list allocated for reuse
+    set->size = 0;
+    set->num = 0;
+    (void)xcsf;
+}
+
+void set_remove(XCSF *xcsf, SET *set, int i)
 {
-    for(NODE *iter = *set; iter != NULL; iter = iter->next) {
-        cl_update(xcsf, iter->cl, x, y, *num);
+    // removes the i-th classifier by swapping in the last one
+    set->num -= set->list[i]->num;
+    set->size--;
+    set->list[i] = set->list[set->size];
+    (void)xcsf;
+}
+
+void set_update(XCSF *xcsf, SET *mset, double *x, double *y, SET *kset)
+{
+    // the classifier parameters are gathered into contiguous arrays so that
+    // the error, set size, and fitness updates of the set are vectorised
+    int n = mset->size;
+    double err[n], fit[n], num[n], exp[n], size[n], mse[n];
+    kernel_update(xcsf, mset->list, n, x, y, mse);
+    for(int i = 0; i < n; i++) {
+        CL *c = mset->list[i];
+        err[i] = c->err;
+        fit[i] = c->fit;
+        num[i] = c->num;
+        exp[i] = c->exp;
+        size[i] = c->size;
+    }
+    set_update_err(xcsf, n, err, exp, mse);
+    set_update_size(xcsf, n, size, exp, mset->num);
+    set_update_fit(xcsf, n, fit, err, num, mset->num);
+    for(int i = 0; i < n; i++) {
+        CL *c = mset->list[i];
+        c->err = err[i];
+        c->fit = fit[i];
+        c->size = size[i];
+        pop_update_cl(xcsf, c);
     }
-    set_update_fit(xcsf, set, *size, *num);
     if(xcsf->SET_SUBSUMPTION) {
-        set_subsumption(xcsf, set, size, num, kset);
+        set_subsumption(xcsf, mset, kset);
+    }
+}
+
+void set_update_err(XCSF *xcsf, int n, double *err, double *exp, double *mse)
+{
+    // sample average over the first 1/BETA updates, then the delta rule
+    for(int i = 0; i < n; i++) {
+        err[i] = (exp[i] < 1.0/xcsf->BETA) ?
+            (err[i] * (exp[i]-1.0) + mse[i]) / exp[i] :
+            err[i] + xcsf->BETA * (mse[i] - err[i]);
+    }
+}
+
+void set_update_size(XCSF *xcsf, int n, double *size, double *exp, int set_num)
+{
+    for(int i = 0; i < n; i++) {
+        size[i] = (exp[i] < 1.0/xcsf->BETA) ?
+            (size[i] * (exp[i]-1.0) + set_num) / exp[i] :
+            size[i] + xcsf->BETA * (set_num - size[i]);
     }
 }
 
-void set_update_fit(XCSF *xcsf, NODE **set, int size, int num_sum)
+void set_update_fit(XCSF *xcsf, int n, double *fit, double *err, double *num, int set_num)
 {
+    double eps_0 = xcsf->EPS_0;
+    double alpha = xcsf->ALPHA;
+    double nu = xcsf->NU;
+    double beta = xcsf->BETA;
     double acc_sum = 0.0;
-    double accs[size];
+    double acc[n];
     // calculate accuracies
-    int i = 0;
-    for(NODE *iter = *set; iter != NULL; iter = iter->next) {
-        accs[i] = cl_acc(xcsf, iter->cl);
-        acc_sum += accs[i] * num_sum;
-        i++;
+    for(int i = 0; i < n; i++) {
+        acc[i] = (err[i] <= eps_0) ? 1.0 : alpha * pow(err[i] / eps_0, -nu);
+        acc_sum += acc[i] * set_num;
     }
     // update fitnesses
-    i = 0;
-    for(NODE *iter = *set; iter != NULL; iter = iter->next) {
-        cl_update_fit(xcsf, iter->cl, acc_sum, accs[i]);
-        i++;
+    for(int i = 0; i < n; i++) {
+        fit[i] += beta * ((acc[i] * num[i]) / acc_sum - fit[i]);
     }
 }
 
-void set_subsumption(XCSF *xcsf, NODE **set, int *size, int *num, NODE **kset)
+void set_subsumption(XCSF *xcsf, SET *mset, SET *kset)
 {
     CL *s = NULL;
-    NODE *iter;
     // find the most general subsumer in the set
-    for(iter = *set; iter != NULL; iter = iter->next) {
-        CL *c = iter->cl;
+    for(int i = 0; i < mset->size; i++) {
+        CL *c = mset->list[i];
         if(cl_subsumer(xcsf, c)) {
             if(s == NULL || cl_general(xcsf, c, s)) {
                 s = c;
@@ -268,122 +603,93 @@ void set_subsumption(XCSF *xcsf, NODE **set, int *size, int *num, NODE **kset)
     }
     // subsume the more specific classifiers in the set
     if(s != NULL) {
-        iter = *set; 
-        while(iter != NULL) {
-            CL *c = iter->cl;
-            iter = iter->next;
-            if(cl_general(xcsf, s, c)) {
+        _Bool subsumed = false;
+        for(int i = 0; i < mset->size; i++) {
+            CL *c = mset->list[i];
+            if(c != s && cl_general(xcsf, s, c)) {
                 s->num += c->num;
                 c->num = 0;
                 set_add(xcsf, kset, c);
-                set_validate(xcsf, set, size, num);
-                set_validate(xcsf, &xcsf->pset, &xcsf->pop_num, &xcsf->pop_num_sum);
+                pop_remove(xcsf, c);
+                subsumed = true;
             }
         }
+        if(subsumed) {
+            // compact the match set once, dropping those with 0 numerosity
+            set_validate(xcsf, mset);
+            pop_update_cl(xcsf, s);
+        }
     }
 }
 
-void set_validate(XCSF *xcsf, NODE **set, int *size, int *num)
+void set_validate(XCSF *xcsf, SET *set)
 {
-    // remove nodes pointing to classifiers with 0 numerosity
-    *size = 0;
-    *num = 0;
-    NODE *prev = NULL;
-    NODE *iter = *set;
-    while(iter != NULL) {
-        if(iter->cl == NULL || iter->cl->num == 0) {
-            if(prev == NULL) {
-                *set = iter->next;
-                free(iter);
-                iter = *set;
-            }
-            else {
-                prev->next = iter->next;
-                free(iter);
-                iter = prev->next;
-            }
-        }
-        else {
-            (*size)++;
-            (*num) += iter->cl->num;
-            prev = iter;
-            iter = iter->next;
+    // remove classifiers with 0 numerosity
+    int j = 0;
+    set->num = 0;
+    for(int i = 0; i < set->size; i++) {
+        CL *c = set->list[i];
+        if(c != NULL && c->num > 0) {
+            set->list[j] = c;
+            set->num += c->num;
+            j++;
         }
     }
+    set->size = j;
     (void)xcsf;
 }
 
-void set_print(XCSF *xcsf, NODE *set, _Bool print_cond, _Bool print_pred)
+void set_print(XCSF *xcsf, SET *set, _Bool print_cond, _Bool print_pred)
 {
-    for(NODE *iter = set; iter != NULL; iter = iter->next) {
-        cl_print(xcsf, iter->cl, print_cond, print_pred);
+    for(int i = 0; i < set->size; i++) {
+        cl_print(xcsf, set->list[i], print_cond, print_pred);
     }
 }
 
-void set_times(XCSF *xcsf, NODE **set)
+void set_times(XCSF *xcsf, SET *set)
 {
-    for(NODE *iter = *set; iter != NULL; iter = iter->next) {
-        iter->cl->time = xcsf->time;
+    for(int i = 0; i < set->size; i++) {
+        set->list[i]->time = xcsf->time;
     }
 }
 
-double set_total_fit(XCSF *xcsf, NODE **set)
+double set_total_fit(XCSF *xcsf, SET *set)
 {
     double sum = 0.0;
-    for(NODE *iter = *set; iter != NULL; iter = iter->next) {
-        sum += iter->cl->fit;
+    for(int i = 0; i < set->size; i++) {
+        sum += set->list[i]->fit;
     }
     (void)xcsf;
     return sum;
 }
 
-double set_total_time(XCSF *xcsf, NODE **set)
+double set_total_time(XCSF *xcsf, SET *set)
 {
     double sum = 0.0;
-    for(NODE *iter = *set; iter != NULL; iter = iter->next) {
-        sum += iter->cl->time * iter->cl->num;
+    for(int i = 0; i < set->size; i++) {
+        sum += set->list[i]->time * set->list[i]->num;
     }
     (void)xcsf;
     return sum;
 }
 
-double set_mean_time(XCSF *xcsf, NODE **set, int num_sum)
+double set_mean_time(XCSF *xcsf, SET *set)
 {
-    return set_total_time(xcsf, set) / num_sum;
+    return set_total_time(xcsf, set) / set->num;
 }
 
-void set_free(XCSF *xcsf, NODE **set)
+void set_free(XCSF *xcsf, SET *set)
 {
     // frees the set only, not the classifiers
-    NODE *iter = *set;
-    while(iter != NULL) {
-        *set = iter->next;
-        free(iter);
-        iter = *set;
-    }
-    (void)xcsf;
+    free(set->list);
+    set_init(xcsf, set);
 }
 
-void set_kill(XCSF *xcsf, NODE **set)
+void set_kill(XCSF *xcsf, SET *set)
 {
     // frees the set and classifiers
-    NODE *iter = *set;
-    while(iter != NULL) {
-        cl_free(xcsf, iter->cl);
-        *set = iter->next;
-        free(iter);
-        iter = *set;
-    }
-}
-
-double set_avg_mut(XCSF *xcsf, NODE **set, int m)
-{
-    // returns the average classifier mutation rate
-    double sum = 0.0;
-    int cnt = 0;
-    for(NODE *iter = *set; iter != NULL; iter = iter->next) {
-        sum += cl_mutation_rate(xcsf, iter->cl, m);
-        cnt++;
+    for(int i = 0; i < set->size; i++) {
+        cl_free(xcsf, set->list[i]);
     }
-    return sum/cnt;
+    set_free(xcsf, set);
 }
@@ -26,10 +26,10 @@
 #include "cl.h"
 #include "dgp.h"
 #include "cond_dgp.h"
+#include "cl_index.h"
 
 typedef struct COND_DGP {
 	GRAPH dgp;
-	_Bool m;
 	double *mu;
 } COND_DGP;
 
@@ -41,6 +41,13 @@ void cond_dgp_init(XCSF *xcsf, CL *c)
 	sam_init(xcsf, &cond->mu);
 }
 
+void cond_dgp_reinit(XCSF *xcsf, CL *c)
+{
+	COND_DGP *cond = c->cond;
+	graph_reinit(xcsf, &cond->dgp);
+	sam_reinit(xcsf, cond->mu);
+}
+
 void cond_dgp_free(XCSF *xcsf, CL *c)
 {
 	COND_DGP *cond = c->cond;
@@ -56,6 +63,33 @@ double cond_dgp_mu(XCSF *xcsf, CL *c, int m)
 	return cond->mu[m];
 }
 
+size_t cond_dgp_bytes(XCSF *xcsf)
+{
+	// allocated separately from the classifier
+	(void)xcsf;
+	return 0;
+}
+
+size_t cond_dgp_heap(XCSF *xcsf, CL *c)
+{
+	COND_DGP *cond = c->cond;
+	return sizeof(COND_DGP) + sizeof(double) * xcsf->NUM_SAM +
+		graph_heap(xcsf, &cond->dgp);
+}
+
+uint64_t cond_dgp_hash(XCSF *xcsf, CL *c)
+{
+	COND_DGP *cond = c->cond;
+	return graph_hash(xcsf, &cond->dgp);
+}
+
+_Bool cond_dgp_equal(XCSF *xcsf, CL *c1, CL *c2)
+{
+	COND_DGP *cond1 = c1->cond;
+	COND_DGP *cond2 = c2->cond;
+	return graph_equal(xcsf, &cond1->dgp, &cond2->dgp);
+}
+
 void cond_dgp_copy(XCSF *xcsf, CL *to, CL *from)
 {
 	COND_DGP *to_cond = to->cond;
@@ -72,10 +106,19 @@ void cond_dgp_rand(XCSF *xcsf, CL *c)
 
 void cond_dgp_cover(XCSF *xcsf, CL *c, double *state)
 {
-	// generates random graphs until the network matches for input state
-	do {
+	// generates random graphs until the network matches for input state;
+	// after COVER_TRIES failures the output node is rewired so that it does
+	COND_DGP *cond = c->cond;
+	_Bool match = false;
+	for(int i = 0; i < COVER_TRIES && !match; i++) {
 		cond_dgp_rand(xcsf, c);
-	} while(!cond_dgp_match(xcsf, c, state));
+		match = cond_dgp_match(xcsf, c, state);
+		xcsf->cover_tries++;
+	}
+	if(!match) {
+		graph_cover(xcsf, &cond->dgp, state, 0.5);
+		xcsf->cover_built++;
+	}
 }
 
 _Bool cond_dgp_match(XCSF *xcsf, CL *c, double *state)
@@ -84,21 +127,11 @@ _Bool cond_dgp_match(XCSF *xcsf, CL *c, double *state)
 	COND_DGP *cond = c->cond;
 	graph_update(xcsf, &cond->dgp, state);
 	if(graph_output(xcsf, &cond->dgp, 0) > 0.5) {
-		cond->m = true;
+		return true;
 	}
-	else {
-		cond->m = false;
-	}
-	return cond->m;
+	return false;
 }            
 
-_Bool cond_dgp_match_state(XCSF *xcsf, CL *c)
-{
-	(void)xcsf;
-	COND_DGP *cond = c->cond;
-	return cond->m;
-}
-
 _Bool cond_dgp_mutate(XCSF *xcsf, CL *c)
 {
 	COND_DGP *cond = c->cond;
@@ -112,6 +145,16 @@ _Bool cond_dgp_mutate(XCSF *xcsf, CL *c)
 	return mod;
 }
 
+_Bool cond_dgp_box(XCSF *xcsf, CL *c, double *lower, double *upper)
+{
+	// no bounding box of the matching region is available
+	(void)xcsf;
+	(void)c;
+	(void)lower;
+	(void)upper;
+	return false;
+}
+
 _Bool cond_dgp_crossover(XCSF *xcsf, CL *c1, CL *c2)
 {
 	(void)xcsf;
@@ -17,29 +17,39 @@
  */
 
 _Bool cond_dgp_crossover(XCSF *xcsf, CL *c1, CL *c2);
+_Bool cond_dgp_equal(XCSF *xcsf, CL *c1, CL *c2);
 _Bool cond_dgp_general(XCSF *xcsf, CL *c1, CL *c2);
 _Bool cond_dgp_match(XCSF *xcsf, CL *c, double *x);
-_Bool cond_dgp_match_state(XCSF *xcsf, CL *c);
 _Bool cond_dgp_mutate(XCSF *xcsf, CL *c);
+_Bool cond_dgp_box(XCSF *xcsf, CL *c, double *lower, double *upper);
 void cond_dgp_copy(XCSF *xcsf, CL *to, CL *from);
 void cond_dgp_cover(XCSF *xcsf, CL *c, double *x);
 void cond_dgp_free(XCSF *xcsf, CL *c);
 void cond_dgp_init(XCSF *xcsf, CL *c);
 void cond_dgp_print(XCSF *xcsf, CL *c);
 void cond_dgp_rand(XCSF *xcsf, CL *c);
+void cond_dgp_reinit(XCSF *xcsf, CL *c);
 double cond_dgp_mu(XCSF *xcsf, CL *c, int m);
+size_t cond_dgp_bytes(XCSF *xcsf);
+size_t cond_dgp_heap(XCSF *xcsf, CL *c);
+uint64_t cond_dgp_hash(XCSF *xcsf, CL *c);
 
 static struct CondVtbl const cond_dgp_vtbl = {
 	&cond_dgp_crossover,
+	&cond_dgp_equal,
 	&cond_dgp_general,
 	&cond_dgp_match,
-	&cond_dgp_match_state,
 	&cond_dgp_mutate,
+	&cond_dgp_box,
 	&cond_dgp_mu,
+	&cond_dgp_bytes,
+	&cond_dgp_heap,
+	&cond_dgp_hash,
 	&cond_dgp_copy,
 	&cond_dgp_cover,
 	&cond_dgp_free,
 	&cond_dgp_init,
 	&cond_dgp_print,
-	&cond_dgp_rand
+	&cond_dgp_rand,
+	&cond_dgp_reinit
 };      
@@ -29,26 +29,59 @@
 #include "random.h"
 #include "cl.h"
 #include "cond_dummy.h"
+#include "cl_index.h"
 
 typedef struct COND_DUMMY {
-	_Bool m;
 	double *mu;
 } COND_DUMMY;
 
 void cond_dummy_init(XCSF *xcsf, CL *c)
 {
-	COND_DUMMY *cond = malloc(sizeof(COND_DUMMY));
-	c->cond = cond;
-	sam_init(xcsf, &cond->mu);
+	// the condition is stored within the classifier's memory block
+	COND_DUMMY *cond = c->cond;
+	cond->mu = (double *) (cond + 1);
+	sam_reinit(xcsf, cond->mu);
+}
+
+size_t cond_dummy_bytes(XCSF *xcsf)
+{
+	return sizeof(COND_DUMMY) + sizeof(double) * xcsf->NUM_SAM;
+}
+
+size_t cond_dummy_heap(XCSF *xcsf, CL *c)
+{
+	// stored within the classifier's memory block
 	(void)xcsf;
+	(void)c;
+	return 0;
 }
 
-void cond_dummy_free(XCSF *xcsf, CL *c)
+uint64_t cond_dummy_hash(XCSF *xcsf, CL *c)
+{
+	(void)xcsf;
+	(void)c;
+	return HASH_SEED;
+}
+
+_Bool cond_dummy_equal(XCSF *xcsf, CL *c1, CL *c2)
+{
+	(void)xcsf;
+	(void)c1;
+	(void)c2;
+	return true;
+}
+
+void cond_dummy_reinit(XCSF *xcsf, CL *c)
 {
 	COND_DUMMY *cond = c->cond;
-	sam_free(xcsf, cond->mu);
-	free(c->cond);
+	sam_reinit(xcsf, cond->mu);
+}
+
+void cond_dummy_free(XCSF *xcsf, CL *c)
+{
+	// freed along with the classifier
 	(void)xcsf;
+	(void)c;
 }
 
 double cond_dummy_mu(XCSF *xcsf, CL *c, int m)
@@ -82,16 +115,8 @@ _Bool cond_dummy_match(XCSF *xcsf, CL *c, double *state)
 {
 	(void)xcsf;
 	(void)state;
-	COND_DUMMY *cond = c->cond;
-	cond->m = true;
-	return cond->m;
-}
-
-_Bool cond_dummy_match_state(XCSF *xcsf, CL *c)
-{
-	(void)xcsf;
-	COND_DUMMY *cond = c->cond;
-	return cond->m;
+	(void)c;
+	return true;
 }
 
 _Bool cond_dummy_crossover(XCSF *xcsf, CL *c1, CL *c2) 
@@ -109,6 +134,16 @@ _Bool cond_dummy_mutate(XCSF *xcsf, CL *c)
 	return false;
 }
 
+_Bool cond_dummy_box(XCSF *xcsf, CL *c, double *lower, double *upper)
+{
+	// no bounding box of the matching region is available
+	(void)xcsf;
+	(void)c;
+	(void)lower;
+	(void)upper;
+	return false;
+}
+
 _Bool cond_dummy_general(XCSF *xcsf, CL *c1, CL *c2)
 {
 	(void)xcsf;
@@ -16,29 +16,39 @@
  */
 
 _Bool cond_dummy_crossover(XCSF *xcsf, CL *c1, CL *c2);
+_Bool cond_dummy_equal(XCSF *xcsf, CL *c1, CL *c2);
 _Bool cond_dummy_general(XCSF *xcsf, CL *c1, CL *c2);
 _Bool cond_dummy_match(XCSF *xcsf, CL *c, double *x);
-_Bool cond_dummy_match_state(XCSF *xcsf, CL *c);
 _Bool cond_dummy_mutate(XCSF *xcsf, CL *c);
+_Bool cond_dummy_box(XCSF *xcsf, CL *c, double *lower, double *upper);
 void cond_dummy_copy(XCSF *xcsf, CL *to, CL *from);
 void cond_dummy_cover(XCSF *xcsf, CL *c, double *x);
 void cond_dummy_free(XCSF *xcsf, CL *c);
 void cond_dummy_init(XCSF *xcsf, CL *c);
 void cond_dummy_print(XCSF *xcsf, CL *c);
 void cond_dummy_rand(XCSF *xcsf, CL *c);
+void cond_dummy_reinit(XCSF *xcsf, CL *c);
 double cond_dummy_mu(XCSF *xcsf, CL *c, int m);
+size_t cond_dummy_bytes(XCSF *xcsf);
+size_t cond_dummy_heap(XCSF *xcsf, CL *c);
+uint64_t cond_dummy_hash(XCSF *xcsf, CL *c);
 
 static struct CondVtbl const cond_dummy_vtbl = {
 	&cond_dummy_crossover,
+	&cond_dummy_equal,
 	&cond_dummy_general,
 	&cond_dummy_match,
-	&cond_dummy_match_state,
 	&cond_dummy_mutate,
+	&cond_dummy_box,
 	&cond_dummy_mu,
+	&cond_dummy_bytes,
+	&cond_dummy_heap,
+	&cond_dummy_hash,
 	&cond_dummy_copy,
 	&cond_dummy_cover,
 	&cond_dummy_free,
 	&cond_dummy_init,
 	&cond_dummy_print,
-	&cond_dummy_rand
+	&cond_dummy_rand,
+	&cond_dummy_reinit
 };     
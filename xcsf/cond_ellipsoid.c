@@ -34,32 +34,103 @@
 #include "random.h"
 #include "cl.h"
 #include "cond_ellipsoid.h"
+#include "cl_index.h"
 
 typedef struct COND_ELLIPSOID {
 	double *center;
 	double *radius;
-	_Bool m;
+	double *inv_radius; // reciprocal of each radius
 	double *mu;
 } COND_ELLIPSOID;
 
-double cond_ellipsoid_dist(XCSF *xcsf, CL *c, double *x);
+#define ELLIPSOID_BLOCK 4 // dimensions summed between early exit tests
+
+void cond_ellipsoid_radius(COND_ELLIPSOID *cond, int i, double r);
+
+static inline double cond_ellipsoid_dist(COND_ELLIPSOID *cond, double *x, int n)
+{
+	// squared distance, summed over blocks of dimensions that vectorise; the
+	// sum is abandoned once it reaches 1 so is only exact for matching inputs
+	double dist = 0.0;
+	int i = 0;
+	for(; i + ELLIPSOID_BLOCK <= n; i += ELLIPSOID_BLOCK) {
+		for(int k = 0; k < ELLIPSOID_BLOCK; k++) {
+			double d = (x[i+k] - cond->center[i+k]) * cond->inv_radius[i+k];
+			dist += d*d;
+		}
+		if(dist >= 1.0) {
+			return dist;
+		}
+	}
+	for(; i < n; i++) {
+		double d = (x[i] - cond->center[i]) * cond->inv_radius[i];
+		dist += d*d;
+	}
+	return dist;
+}
+
+// the distance over a number of variables known at compile time, so that
+// the blocks are unrolled
+#define COND_ELLIPSOID_MATCH_DIM(n) \
+	_Bool cond_ellipsoid_match_##n(XCSF *xcsf, CL *c, double *x) \
+	{ \
+		(void)xcsf; \
+		return cond_ellipsoid_dist(c->cond, x, n) < 1.0; \
+	}
+#define COND_ELLIPSOID_MATCH_CASE(n) case n: return cond_ellipsoid_match_##n(xcsf, c, x);
+
+CL_FIXED_DIMS(COND_ELLIPSOID_MATCH_DIM)
 
 void cond_ellipsoid_init(XCSF *xcsf, CL *c)
 {
-	COND_ELLIPSOID *cond = malloc(sizeof(COND_ELLIPSOID));
-	cond->center = malloc(sizeof(double) * xcsf->num_x_vars);
-	cond->radius = malloc(sizeof(double) * xcsf->num_x_vars); 
-	c->cond = cond;
-	sam_init(xcsf, &cond->mu);
+	// the condition is stored within the classifier's memory block:
+	// [COND_ELLIPSOID][center][radius][inv_radius][mu]
+	COND_ELLIPSOID *cond = c->cond;
+	cond->center = (double *) (cond + 1);
+	cond->radius = cond->center + xcsf->num_x_vars;
+	cond->inv_radius = cond->radius + xcsf->num_x_vars;
+	cond->mu = cond->inv_radius + xcsf->num_x_vars;
+	sam_reinit(xcsf, cond->mu);
+}
+
+size_t cond_ellipsoid_bytes(XCSF *xcsf)
+{
+	return sizeof(COND_ELLIPSOID) + sizeof(double) * (3 * xcsf->num_x_vars + xcsf->NUM_SAM);
 }
 
-void cond_ellipsoid_free(XCSF *xcsf, CL *c)
+size_t cond_ellipsoid_heap(XCSF *xcsf, CL *c)
+{
+	// stored within the classifier's memory block
+	(void)xcsf;
+	(void)c;
+	return 0;
+}
+
+uint64_t cond_ellipsoid_hash(XCSF *xcsf, CL *c)
+{
+	// center and radius are contiguous
+	COND_ELLIPSOID *cond = c->cond;
+	return hash_bytes(cond->center, sizeof(double) * 2 * xcsf->num_x_vars, HASH_SEED);
+}
+
+_Bool cond_ellipsoid_equal(XCSF *xcsf, CL *c1, CL *c2)
+{
+	COND_ELLIPSOID *cond1 = c1->cond;
+	COND_ELLIPSOID *cond2 = c2->cond;
+	return memcmp(cond1->center, cond2->center, sizeof(double) * 2 * xcsf->num_x_vars) == 0;
+}
+
+void cond_ellipsoid_reinit(XCSF *xcsf, CL *c)
 {
 	COND_ELLIPSOID *cond = c->cond;
-	free(cond->center);
-	free(cond->radius);
-	sam_free(xcsf, cond->mu);
-	free(c->cond);
+	sam_reinit(xcsf, cond->mu);
+}
+
+void cond_ellipsoid_free(XCSF *xcsf, CL *c)
+{
+	// freed along with the classifier
+	(void)xcsf;
+	(void)c;
 }
 
 double cond_ellipsoid_mu(XCSF *xcsf, CL *c, int m)
@@ -73,9 +144,9 @@ void cond_ellipsoid_copy(XCSF *xcsf, CL *to, CL *from)
 {
 	COND_ELLIPSOID *to_cond = to->cond;
 	COND_ELLIPSOID *from_cond = from->cond;
-	memcpy(to_cond->center, from_cond->center, sizeof(double)*xcsf->num_x_vars);
-	memcpy(to_cond->radius, from_cond->radius, sizeof(double)*xcsf->num_x_vars);
-	sam_copy(xcsf, to_cond->mu, from_cond->mu);
+	// center, radius, inv_radius, and mu are contiguous
+	memcpy(to_cond->center, from_cond->center, 
+			sizeof(double) * (3 * xcsf->num_x_vars + xcsf->NUM_SAM));
 }                             
 
 void cond_ellipsoid_rand(XCSF *xcsf, CL *c)
@@ -83,7 +154,7 @@ void cond_ellipsoid_rand(XCSF *xcsf, CL *c)
 	COND_ELLIPSOID *cond = c->cond;
 	for(int i = 0; i < xcsf->num_x_vars; i++) {
 		cond->center[i] = ((xcsf->MAX_CON - xcsf->MIN_CON) * drand()) + xcsf->MIN_CON;
-		cond->radius[i] = (xcsf->MAX_CON - xcsf->MIN_CON) * drand() * 0.5;
+		cond_ellipsoid_radius(cond, i, (xcsf->MAX_CON - xcsf->MIN_CON) * drand() * 0.5);
 	}
 }
 
@@ -92,40 +163,29 @@ void cond_ellipsoid_cover(XCSF *xcsf, CL *c, double *x)
 	COND_ELLIPSOID *cond = c->cond;
 	for(int i = 0; i < xcsf->num_x_vars; i++) {
 		cond->center[i] = x[i];
-		cond->radius[i] = (xcsf->MAX_CON - xcsf->MIN_CON) * drand() * 0.5;
+		cond_ellipsoid_radius(cond, i, (xcsf->MAX_CON - xcsf->MIN_CON) * drand() * 0.5);
 	}
 }
 
 _Bool cond_ellipsoid_match(XCSF *xcsf, CL *c, double *x)
 {
-	COND_ELLIPSOID *cond = c->cond;
-	if(cond_ellipsoid_dist(xcsf, c, x) < 1.0) {
-		cond->m = true;
+	switch(xcsf->num_x_vars) {
+		CL_FIXED_DIMS(COND_ELLIPSOID_MATCH_CASE)
+		default: break;
 	}
-	else {
-		cond->m = false;
+	if(cond_ellipsoid_dist(c->cond, x, xcsf->num_x_vars) < 1.0) {
+		return true;
 	}
-	return cond->m;
+	return false;
 }
- 
-double cond_ellipsoid_dist(XCSF *xcsf, CL *c, double *x)
+
+void cond_ellipsoid_radius(COND_ELLIPSOID *cond, int i, double r)
 {
-	COND_ELLIPSOID *cond = c->cond;
-	double dist = 0.0;
-	for(int i = 0; i < xcsf->num_x_vars; i++) {
-		double d = (x[i] - cond->center[i]) / cond->radius[i];
-		dist += d*d; // squared distance
-	}
-	return dist;
+	// sets a radius along with its reciprocal used when matching
+	cond->radius[i] = r;
+	cond->inv_radius[i] = 1.0 / r;
 }
  
-_Bool cond_ellipsoid_match_state(XCSF *xcsf, CL *c)
-{
-	(void)xcsf;
-	COND_ELLIPSOID *cond = c->cond;
-	return cond->m;
-}
-
 _Bool cond_ellipsoid_crossover(XCSF *xcsf, CL *c1, CL *c2) 
 {
 	COND_ELLIPSOID *cond1 = c1->cond;
@@ -141,8 +201,8 @@ _Bool cond_ellipsoid_crossover(XCSF *xcsf, CL *c1, CL *c2)
 			}
 			if(drand() < 0.5) {
 				double tmp = cond1->radius[i];
-				cond1->radius[i] = cond2->radius[i];
-				cond2->radius[i] = tmp;
+				cond_ellipsoid_radius(cond1, i, cond2->radius[i]);
+				cond_ellipsoid_radius(cond2, i, tmp);
 				changed = true;
 			}
 		}
@@ -175,13 +235,26 @@ _Bool cond_ellipsoid_mutate(XCSF *xcsf, CL *c)
 			changed = true;
 		}
 		if(drand() < xcsf->P_MUTATION) {
-			cond->radius[i] += ((drand()*2.0)-1.0)*step;
+			cond_ellipsoid_radius(cond, i, cond->radius[i] + ((drand()*2.0)-1.0)*step);
 			changed = true;
 		}
 	}
 	return changed;
 }
 
+_Bool cond_ellipsoid_box(XCSF *xcsf, CL *c, double *lower, double *upper)
+{
+	// the matching region lies within center +/- radius on each axis; the
+	// distance is squared so a mutated negative radius spans the same region
+	COND_ELLIPSOID *cond = c->cond;
+	for(int i = 0; i < xcsf->num_x_vars; i++) {
+		double r = fabs(cond->radius[i]);
+		lower[i] = cond->center[i] - r;
+		upper[i] = cond->center[i] + r;
+	}
+	return true;
+}
+
 _Bool cond_ellipsoid_general(XCSF *xcsf, CL *c1, CL *c2)
 {
 	// returns whether cond1 is more general than cond2
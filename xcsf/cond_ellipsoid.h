@@ -16,29 +16,39 @@
  */
 
 _Bool cond_ellipsoid_crossover(XCSF *xcsf, CL *c1, CL *c2);
+_Bool cond_ellipsoid_equal(XCSF *xcsf, CL *c1, CL *c2);
 _Bool cond_ellipsoid_general(XCSF *xcsf, CL *c1, CL *c2);
 _Bool cond_ellipsoid_match(XCSF *xcsf, CL *c, double *x);
-_Bool cond_ellipsoid_match_state(XCSF *xcsf, CL *c);
 _Bool cond_ellipsoid_mutate(XCSF *xcsf, CL *c);
+_Bool cond_ellipsoid_box(XCSF *xcsf, CL *c, double *lower, double *upper);
 void cond_ellipsoid_copy(XCSF *xcsf, CL *to, CL *from);
 void cond_ellipsoid_cover(XCSF *xcsf, CL *c, double *x);
 void cond_ellipsoid_free(XCSF *xcsf, CL *c);
 void cond_ellipsoid_init(XCSF *xcsf, CL *c);
 void cond_ellipsoid_print(XCSF *xcsf, CL *c);
 void cond_ellipsoid_rand(XCSF *xcsf, CL *c);
+void cond_ellipsoid_reinit(XCSF *xcsf, CL *c);
 double cond_ellipsoid_mu(XCSF *xcsf, CL *c, int m);
+size_t cond_ellipsoid_bytes(XCSF *xcsf);
+size_t cond_ellipsoid_heap(XCSF *xcsf, CL *c);
+uint64_t cond_ellipsoid_hash(XCSF *xcsf, CL *c);
 
 static struct CondVtbl const cond_ellipsoid_vtbl = {
 	&cond_ellipsoid_crossover,
+	&cond_ellipsoid_equal,
 	&cond_ellipsoid_general,
 	&cond_ellipsoid_match,
-	&cond_ellipsoid_match_state,
 	&cond_ellipsoid_mutate,
+	&cond_ellipsoid_box,
 	&cond_ellipsoid_mu,
+	&cond_ellipsoid_bytes,
+	&cond_ellipsoid_heap,
+	&cond_ellipsoid_hash,
 	&cond_ellipsoid_copy,
 	&cond_ellipsoid_cover,
 	&cond_ellipsoid_free,
 	&cond_ellipsoid_init,
 	&cond_ellipsoid_print,
-	&cond_ellipsoid_rand
+	&cond_ellipsoid_rand,
+	&cond_ellipsoid_reinit
 };      
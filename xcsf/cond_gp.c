@@ -33,11 +33,11 @@
 #include "data_structures.h"
 #include "cl.h"
 #include "cond_gp.h"
+#include "cl_index.h"
 #include "gp.h"
 
 typedef struct COND_GP {
 	GP_TREE gp;
-	_Bool m;
 	double *mu;
 } COND_GP;
 
@@ -49,6 +49,12 @@ void cond_gp_init(XCSF *xcsf, CL *c)
 	sam_init(xcsf, &cond->mu);
 }
 
+void cond_gp_reinit(XCSF *xcsf, CL *c)
+{
+	COND_GP *cond = c->cond;
+	sam_reinit(xcsf, cond->mu);
+}
+
 void cond_gp_free(XCSF *xcsf, CL *c)
 {
 	COND_GP *cond = c->cond;
@@ -64,6 +70,33 @@ double cond_gp_mu(XCSF *xcsf, CL *c, int m)
 	return cond->mu[m];
 }
 
+size_t cond_gp_bytes(XCSF *xcsf)
+{
+	// allocated separately from the classifier
+	(void)xcsf;
+	return 0;
+}
+
+size_t cond_gp_heap(XCSF *xcsf, CL *c)
+{
+	COND_GP *cond = c->cond;
+	return sizeof(COND_GP) + sizeof(double) * xcsf->NUM_SAM +
+		tree_heap(xcsf, &cond->gp);
+}
+
+uint64_t cond_gp_hash(XCSF *xcsf, CL *c)
+{
+	COND_GP *cond = c->cond;
+	return tree_hash(xcsf, &cond->gp);
+}
+
+_Bool cond_gp_equal(XCSF *xcsf, CL *c1, CL *c2)
+{
+	COND_GP *cond1 = c1->cond;
+	COND_GP *cond2 = c2->cond;
+	return tree_equal(xcsf, &cond1->gp, &cond2->gp);
+}
+
 void cond_gp_copy(XCSF *xcsf, CL *to, CL *from)
 {
 	COND_GP *to_cond = to->cond;
@@ -75,16 +108,24 @@ void cond_gp_copy(XCSF *xcsf, CL *to, CL *from)
 void cond_gp_rand(XCSF *xcsf, CL *c)
 {
 	COND_GP *cond = c->cond;
-	tree_free(xcsf, &cond->gp);
 	tree_rand(xcsf, &cond->gp);
 }
 
 void cond_gp_cover(XCSF *xcsf, CL *c, double *state)
 {
-	// generates random weights until the tree matches for input state
-	do {
+	// generates random trees until the tree matches for input state; after
+	// COVER_TRIES failures a terminal is added or subtracted so that it does
+	COND_GP *cond = c->cond;
+	_Bool match = false;
+	for(int i = 0; i < COVER_TRIES && !match; i++) {
 		cond_gp_rand(xcsf, c);
-	} while(!cond_gp_match(xcsf, c, state));
+		match = cond_gp_match(xcsf, c, state);
+		xcsf->cover_tries++;
+	}
+	if(!match) {
+		tree_cover(xcsf, &cond->gp, state, 0.5);
+		xcsf->cover_built++;
+	}
 }
 
 _Bool cond_gp_match(XCSF *xcsf, CL *c, double *state)
@@ -94,21 +135,11 @@ _Bool cond_gp_match(XCSF *xcsf, CL *c, double *state)
 	cond->gp.p = 0;
 	double result = tree_eval(xcsf, &cond->gp, state);
 	if(result > 0.5) {
-		cond->m = true;
-	}
-	else {
-		cond->m = false;
+		return true;
 	}
-	return cond->m;
+	return false;
 }    
 
-_Bool cond_gp_match_state(XCSF *xcsf, CL *c)
-{
-	(void)xcsf;
-	COND_GP *cond = c->cond;
-	return cond->m;
-}
-
 _Bool cond_gp_mutate(XCSF *xcsf, CL *c)
 {
 	COND_GP *cond = c->cond;
@@ -123,9 +154,17 @@ _Bool cond_gp_mutate(XCSF *xcsf, CL *c)
 		tree_mutation(xcsf, &cond->gp, xcsf->P_MUTATION);
 		return true;
 	}
-	else {
-		return false;
-	}
+	return false;
+}
+
+_Bool cond_gp_box(XCSF *xcsf, CL *c, double *lower, double *upper)
+{
+	// no bounding box of the matching region is available
+	(void)xcsf;
+	(void)c;
+	(void)lower;
+	(void)upper;
+	return false;
 }
 
 _Bool cond_gp_crossover(XCSF *xcsf, CL *c1, CL *c2)
@@ -136,9 +175,7 @@ _Bool cond_gp_crossover(XCSF *xcsf, CL *c1, CL *c2)
 		tree_crossover(xcsf, &cond1->gp, &cond2->gp);
 		return true;
 	}
-	else {
-		return false;
-	}
+	return false;
 }
 
 _Bool cond_gp_subsumes(XCSF *xcsf, CL *c1, CL *c2)
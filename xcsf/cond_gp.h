@@ -17,29 +17,39 @@
  */
 
 _Bool cond_gp_crossover(XCSF *xcsf, CL *c1, CL *c2);
+_Bool cond_gp_equal(XCSF *xcsf, CL *c1, CL *c2);
 _Bool cond_gp_general(XCSF *xcsf, CL *c1, CL *c2);
 _Bool cond_gp_match(XCSF *xcsf, CL *c, double *x);
-_Bool cond_gp_match_state(XCSF *xcsf, CL *c);
 _Bool cond_gp_mutate(XCSF *xcsf, CL *c);
+_Bool cond_gp_box(XCSF *xcsf, CL *c, double *lower, double *upper);
 void cond_gp_copy(XCSF *xcsf, CL *to, CL *from);
 void cond_gp_cover(XCSF *xcsf, CL *c, double *x);
 void cond_gp_free(XCSF *xcsf, CL *c);
 void cond_gp_init(XCSF *xcsf, CL *c);
 void cond_gp_print(XCSF *xcsf, CL *c);
 void cond_gp_rand(XCSF *xcsf, CL *c);
+void cond_gp_reinit(XCSF *xcsf, CL *c);
 double cond_gp_mu(XCSF *xcsf, CL *c, int m);
+size_t cond_gp_bytes(XCSF *xcsf);
+size_t cond_gp_heap(XCSF *xcsf, CL *c);
+uint64_t cond_gp_hash(XCSF *xcsf, CL *c);
 
 static struct CondVtbl const cond_gp_vtbl = {
 	&cond_gp_crossover,
+	&cond_gp_equal,
 	&cond_gp_general,
 	&cond_gp_match,
-	&cond_gp_match_state,
 	&cond_gp_mutate,
+	&cond_gp_box,
 	&cond_gp_mu,
+	&cond_gp_bytes,
+	&cond_gp_heap,
+	&cond_gp_hash,
 	&cond_gp_copy,
 	&cond_gp_cover,
 	&cond_gp_free,
 	&cond_gp_init,
 	&cond_gp_print,
-	&cond_gp_rand
+	&cond_gp_rand,
+	&cond_gp_reinit
 };      
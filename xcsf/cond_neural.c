@@ -34,10 +34,10 @@
 #include "cl.h"
 #include "neural.h"
 #include "cond_neural.h"
+#include "cl_index.h"
 
 typedef struct COND_NEURAL {
 	BPN bpn;
-	_Bool m;
 	double *mu;
 } COND_NEURAL;
 
@@ -85,6 +85,13 @@ void cond_neural_init(XCSF *xcsf, CL *c)
 	sam_init(xcsf, &cond->mu);
 }
 
+void cond_neural_reinit(XCSF *xcsf, CL *c)
+{
+	COND_NEURAL *cond = c->cond;
+	neural_reinit(xcsf, &cond->bpn);
+	sam_reinit(xcsf, cond->mu);
+}
+
 void cond_neural_free(XCSF *xcsf, CL *c)
 {
 	COND_NEURAL *cond = c->cond;
@@ -100,6 +107,33 @@ double cond_neural_mu(XCSF *xcsf, CL *c, int m)
 	return cond->mu[m];
 }
 
+size_t cond_neural_bytes(XCSF *xcsf)
+{
+	// allocated separately from the classifier
+	(void)xcsf;
+	return 0;
+}
+
+size_t cond_neural_heap(XCSF *xcsf, CL *c)
+{
+	COND_NEURAL *cond = c->cond;
+	return sizeof(COND_NEURAL) + sizeof(double) * xcsf->NUM_SAM +
+		neural_heap(xcsf, &cond->bpn);
+}
+
+uint64_t cond_neural_hash(XCSF *xcsf, CL *c)
+{
+	COND_NEURAL *cond = c->cond;
+	return neural_hash(xcsf, &cond->bpn);
+}
+
+_Bool cond_neural_equal(XCSF *xcsf, CL *c1, CL *c2)
+{
+	COND_NEURAL *cond1 = c1->cond;
+	COND_NEURAL *cond2 = c2->cond;
+	return neural_equal(xcsf, &cond1->bpn, &cond2->bpn);
+}
+
 void cond_neural_copy(XCSF *xcsf, CL *to, CL *from)
 {
 	COND_NEURAL *to_cond = to->cond;
@@ -116,10 +150,20 @@ void cond_neural_rand(XCSF *xcsf, CL *c)
 
 void cond_neural_cover(XCSF *xcsf, CL *c, double *x)
 {
-	// generates random weights until the network matches for input state
-	do {
+	// generates random weights until the network matches for input state;
+	// after COVER_TRIES failures the output bias is shifted so that it does,
+	// the logistic output exceeding 0.5 for states above log(3)
+	COND_NEURAL *cond = c->cond;
+	_Bool match = false;
+	for(int i = 0; i < COVER_TRIES && !match; i++) {
 		cond_neural_rand(xcsf, c);
-	} while(!cond_neural_match(xcsf, c, x));
+		match = cond_neural_match(xcsf, c, x);
+		xcsf->cover_tries++;
+	}
+	if(!match) {
+		neural_bias(xcsf, &cond->bpn, 0, log(3.0) + 0.1 + drand());
+		xcsf->cover_built++;
+	}
 }
 
 _Bool cond_neural_match(XCSF *xcsf, CL *c, double *x)
@@ -128,21 +172,11 @@ _Bool cond_neural_match(XCSF *xcsf, CL *c, double *x)
 	COND_NEURAL *cond = c->cond;
 	neural_propagate(xcsf, &cond->bpn, x);
 	if(neural_output(xcsf, &cond->bpn, 0) > 0.5) {
-		cond->m = true;
+		return true;
 	}
-	else {
-		cond->m = false;
-	}
-	return cond->m;
+	return false;
 }                
 
-_Bool cond_neural_match_state(XCSF *xcsf, CL *c)
-{
-	(void)xcsf;
-	COND_NEURAL *cond = c->cond;
-	return cond->m;
-}
-
 _Bool cond_neural_mutate(XCSF *xcsf, CL *c)
 {
 	COND_NEURAL *cond = c->cond;
@@ -167,6 +201,16 @@ _Bool cond_neural_mutate(XCSF *xcsf, CL *c)
 	return mod;
 }
 
+_Bool cond_neural_box(XCSF *xcsf, CL *c, double *lower, double *upper)
+{
+	// no bounding box of the matching region is available
+	(void)xcsf;
+	(void)c;
+	(void)lower;
+	(void)upper;
+	return false;
+}
+
 _Bool cond_neural_crossover(XCSF *xcsf, CL *c1, CL *c2)
 {
 	(void)xcsf;
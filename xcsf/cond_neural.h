@@ -16,29 +16,39 @@
  */
 
 _Bool cond_neural_crossover(XCSF *xcsf, CL *c1, CL *c2);
+_Bool cond_neural_equal(XCSF *xcsf, CL *c1, CL *c2);
 _Bool cond_neural_general(XCSF *xcsf, CL *c1, CL *c2);
 _Bool cond_neural_match(XCSF *xcsf, CL *c, double *x);
-_Bool cond_neural_match_state(XCSF *xcsf, CL *c);
 _Bool cond_neural_mutate(XCSF *xcsf, CL *c);
+_Bool cond_neural_box(XCSF *xcsf, CL *c, double *lower, double *upper);
 void cond_neural_copy(XCSF *xcsf, CL *to, CL *from);
 void cond_neural_cover(XCSF *xcsf, CL *c, double *x);
 void cond_neural_free(XCSF *xcsf, CL *c);
 void cond_neural_init(XCSF *xcsf, CL *c);
 void cond_neural_print(XCSF *xcsf, CL *c);
 void cond_neural_rand(XCSF *xcsf, CL *c);
+void cond_neural_reinit(XCSF *xcsf, CL *c);
 double cond_neural_mu(XCSF *xcsf, CL *c, int m);
+size_t cond_neural_bytes(XCSF *xcsf);
+size_t cond_neural_heap(XCSF *xcsf, CL *c);
+uint64_t cond_neural_hash(XCSF *xcsf, CL *c);
 
 static struct CondVtbl const cond_neural_vtbl = {
 	&cond_neural_crossover,
+	&cond_neural_equal,
 	&cond_neural_general,
 	&cond_neural_match,
-	&cond_neural_match_state,
 	&cond_neural_mutate,
+	&cond_neural_box,
 	&cond_neural_mu,
+	&cond_neural_bytes,
+	&cond_neural_heap,
+	&cond_neural_hash,
 	&cond_neural_copy,
 	&cond_neural_cover,
 	&cond_neural_free,
 	&cond_neural_init,
 	&cond_neural_print,
-	&cond_neural_rand
+	&cond_neural_rand,
+	&cond_neural_reinit
 };      
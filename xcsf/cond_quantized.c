@@ -0,0 +1,347 @@
+/*
+ * Copyright (C) 2019 Richard Preen <rpreen@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **************
+ * Description:
+ **************
+ * The quantized hyperrectangle classifier condition module.
+ *
+ * Provides functionality to create hyperrectangle conditions whose bounds are
+ * stored as 16-bit integers on a fixed grid of QUANTIZED_LEVELS points over
+ * [MIN_CON, MAX_CON], using a quarter of the memory of double bounds. Each
+ * input is quantized onto the grid once per trial so that matching reduces
+ * to branch-free integer compares that the compiler packs into SIMD
+ * instructions. Inputs outside [MIN_CON, MAX_CON] are clamped onto the grid.
+ * Includes operations for copying, mutating, printing, etc.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <math.h>
+#include "data_structures.h"
+#include "random.h"
+#include "cl.h"
+#include "cond_quantized.h"
+#include "cl_index.h"
+
+#define QUANTIZED_LEVELS 65535 // highest grid point
+#define QUANTIZED_BLOCK 16 // variables compared between early exits
+
+typedef struct COND_QUANTIZED {
+	uint16_t *lower;
+	uint16_t *upper;
+	double *mu;
+} COND_QUANTIZED;
+
+double cond_quantized_scale(XCSF *xcsf);
+int cond_quantized_value(XCSF *xcsf, double x);
+size_t cond_quantized_offset(XCSF *xcsf);
+void cond_quantized_bounds(int *l, int *u);
+
+void cond_quantized_init(XCSF *xcsf, CL *c)
+{
+	// the condition is stored within the classifier's memory block:
+	// [COND_QUANTIZED][lower][upper][padding][mu]
+	COND_QUANTIZED *cond = c->cond;
+	cond->lower = (uint16_t *) (cond + 1);
+	cond->upper = cond->lower + xcsf->num_x_vars;
+	cond->mu = (double *) ((char *) cond->lower + cond_quantized_offset(xcsf));
+	sam_reinit(xcsf, cond->mu);
+}
+
+size_t cond_quantized_offset(XCSF *xcsf)
+{
+	// bytes of the bounds, padded to keep the mutation rates aligned
+	size_t bytes = sizeof(uint16_t) * 2 * xcsf->num_x_vars;
+	return (bytes + sizeof(double) - 1) / sizeof(double) * sizeof(double);
+}
+
+size_t cond_quantized_bytes(XCSF *xcsf)
+{
+	return sizeof(COND_QUANTIZED) + cond_quantized_offset(xcsf) +
+		sizeof(double) * xcsf->NUM_SAM;
+}
+
+size_t cond_quantized_heap(XCSF *xcsf, CL *c)
+{
+	// stored within the classifier's memory block
+	(void)xcsf;
+	(void)c;
+	return 0;
+}
+
+double cond_quantized_scale(XCSF *xcsf)
+{
+	// grid points per unit of the input range
+	return QUANTIZED_LEVELS / (xcsf->MAX_CON - xcsf->MIN_CON);
+}
+
+int cond_quantized_value(XCSF *xcsf, double x)
+{
+	// returns the nearest grid point to x
+	double q = (x - xcsf->MIN_CON) * cond_quantized_scale(xcsf);
+	if(!(q > 0.0)) {
+		return 0;
+	}
+	if(q > QUANTIZED_LEVELS) {
+		return QUANTIZED_LEVELS;
+	}
+	return (int) (q + 0.5);
+}
+
+void cond_quantized_input(XCSF *xcsf, double *x, int rows)
+{
+	// quantizes inputs once for matching by every classifier
+	if(xcsf->qx == NULL || xcsf->qx_size < rows) {
+		xcsf->qx_size = rows;
+		xcsf->qx = realloc(xcsf->qx, sizeof(uint16_t) * rows * xcsf->num_x_vars);
+	}
+	for(int i = 0; i < rows * xcsf->num_x_vars; i++) {
+		xcsf->qx[i] = cond_quantized_value(xcsf, x[i]);
+	}
+	xcsf->qx_src = x;
+	xcsf->qx_rows = rows;
+}
+
+uint64_t cond_quantized_hash(XCSF *xcsf, CL *c)
+{
+	// lower and upper are contiguous
+	COND_QUANTIZED *cond = c->cond;
+	return hash_bytes(cond->lower, sizeof(uint16_t) * 2 * xcsf->num_x_vars, HASH_SEED);
+}
+
+_Bool cond_quantized_equal(XCSF *xcsf, CL *c1, CL *c2)
+{
+	COND_QUANTIZED *cond1 = c1->cond;
+	COND_QUANTIZED *cond2 = c2->cond;
+	return memcmp(cond1->lower, cond2->lower, sizeof(uint16_t) * 2 * xcsf->num_x_vars) == 0;
+}
+
+void cond_quantized_reinit(XCSF *xcsf, CL *c)
+{
+	COND_QUANTIZED *cond = c->cond;
+	sam_reinit(xcsf, cond->mu);
+}
+
+void cond_quantized_free(XCSF *xcsf, CL *c)
+{
+	// freed along with the classifier
+	(void)xcsf;
+	(void)c;
+}
+
+double cond_quantized_mu(XCSF *xcsf, CL *c, int m)
+{
+	(void)xcsf;
+	COND_QUANTIZED *cond = c->cond;
+	return cond->mu[m];
+}
+
+void cond_quantized_copy(XCSF *xcsf, CL *to, CL *from)
+{
+	COND_QUANTIZED *to_cond = to->cond;
+	COND_QUANTIZED *from_cond = from->cond;
+	// lower, upper, and mu are contiguous
+	memcpy(to_cond->lower, from_cond->lower,
+			cond_quantized_offset(xcsf) + sizeof(double) * xcsf->NUM_SAM);
+}
+
+void cond_quantized_bounds(int *l, int *u)
+{
+	if(*l < 0) {
+		*l = 0;
+	}
+	else if(*l > QUANTIZED_LEVELS) {
+		*l = QUANTIZED_LEVELS;
+	}
+	if(*u < 0) {
+		*u = 0;
+	}
+	else if(*u > QUANTIZED_LEVELS) {
+		*u = QUANTIZED_LEVELS;
+	}
+	if(*l > *u) {
+		int tmp = *l;
+		*l = *u;
+		*u = tmp;
+	}
+}
+
+void cond_quantized_rand(XCSF *xcsf, CL *c)
+{
+	COND_QUANTIZED *cond = c->cond;
+	for(int i = 0; i < xcsf->num_x_vars; i++) {
+		int l = irand(0, QUANTIZED_LEVELS + 1);
+		int u = irand(0, QUANTIZED_LEVELS + 1);
+		cond_quantized_bounds(&l, &u);
+		cond->lower[i] = l;
+		cond->upper[i] = u;
+	}
+}
+
+void cond_quantized_cover(XCSF *xcsf, CL *c, double *x)
+{
+	COND_QUANTIZED *cond = c->cond;
+	for(int i = 0; i < xcsf->num_x_vars; i++) {
+		int q = cond_quantized_value(xcsf, x[i]);
+		int l = q - (int) (QUANTIZED_LEVELS * drand() * 0.5);
+		int u = q + (int) (QUANTIZED_LEVELS * drand() * 0.5);
+		cond_quantized_bounds(&l, &u);
+		cond->lower[i] = l;
+		cond->upper[i] = u;
+	}
+}
+
+_Bool cond_quantized_match(XCSF *xcsf, CL *c, double *x)
+{
+	COND_QUANTIZED *cond = c->cond;
+	int n = xcsf->num_x_vars;
+	int row = cl_input_row(xcsf, xcsf->qx_src, xcsf->qx_rows, x);
+	if(row < 0) {
+		// the input was not quantized for this trial
+		for(int i = 0; i < n; i++) {
+			int q = cond_quantized_value(xcsf, x[i]);
+			if(cond->lower[i] > q || cond->upper[i] < q) {
+				return false;
+			}
+		}
+		return true;
+	}
+	// compares blocks of variables without branching
+	const uint16_t *q = &xcsf->qx[row * n];
+	for(int i = 0; i < n; i += QUANTIZED_BLOCK) {
+		int end = i + QUANTIZED_BLOCK < n ? i + QUANTIZED_BLOCK : n;
+		int outside = 0;
+		for(int j = i; j < end; j++) {
+			outside |= (cond->lower[j] > q[j]) | (cond->upper[j] < q[j]);
+		}
+		if(outside) {
+			return false;
+		}
+	}
+	return true;
+}
+
+_Bool cond_quantized_crossover(XCSF *xcsf, CL *c1, CL *c2)
+{
+	COND_QUANTIZED *cond1 = c1->cond;
+	COND_QUANTIZED *cond2 = c2->cond;
+	_Bool changed = false;
+	// uniform crossover
+	if(drand() < xcsf->P_CROSSOVER) {
+		for(int i = 0; i < xcsf->num_x_vars; i++) {
+			// lower interval
+			if(drand() < 0.5) {
+				uint16_t tmp = cond1->lower[i];
+				cond1->lower[i] = cond2->lower[i];
+				cond2->lower[i] = tmp;
+				changed = true;
+			}
+			// upper interval
+			if(drand() < 0.5) {
+				uint16_t tmp = cond1->upper[i];
+				cond1->upper[i] = cond2->upper[i];
+				cond2->upper[i] = tmp;
+				changed = true;
+			}
+			int l1 = cond1->lower[i], u1 = cond1->upper[i];
+			int l2 = cond2->lower[i], u2 = cond2->upper[i];
+			cond_quantized_bounds(&l1, &u1);
+			cond_quantized_bounds(&l2, &u2);
+			cond1->lower[i] = l1;
+			cond1->upper[i] = u1;
+			cond2->lower[i] = l2;
+			cond2->upper[i] = u2;
+		}
+	}
+	return changed;
+}
+
+_Bool cond_quantized_mutate(XCSF *xcsf, CL *c)
+{
+	COND_QUANTIZED *cond = c->cond;
+	_Bool changed = false;
+	double step = xcsf->S_MUTATION;
+	// adapt mutation rates
+	if(xcsf->NUM_SAM > 0) {
+		sam_adapt(xcsf, cond->mu);
+		xcsf->P_MUTATION = cond->mu[0];
+		if(xcsf->NUM_SAM > 1) {
+			step = cond->mu[1];
+		}
+	}
+	// the step size is converted to grid points
+	step *= cond_quantized_scale(xcsf);
+	for(int i = 0; i < xcsf->num_x_vars; i++) {
+		int l = cond->lower[i];
+		int u = cond->upper[i];
+		// lower interval
+		if(drand() < xcsf->P_MUTATION) {
+			l += (int) lround(((drand()*2.0)-1.0)*step);
+			changed = true;
+		}
+		// upper interval
+		if(drand() < xcsf->P_MUTATION) {
+			u += (int) lround(((drand()*2.0)-1.0)*step);
+			changed = true;
+		}
+		cond_quantized_bounds(&l, &u);
+		cond->lower[i] = l;
+		cond->upper[i] = u;
+	}
+	return changed;
+}
+
+_Bool cond_quantized_box(XCSF *xcsf, CL *c, double *lower, double *upper)
+{
+	// inputs outside [MIN_CON, MAX_CON] are clamped onto the grid, so the
+	// conditions on its edges have no finite bounding box; the compact
+	// bounds are instead scanned
+	(void)xcsf;
+	(void)c;
+	(void)lower;
+	(void)upper;
+	return false;
+}
+
+_Bool cond_quantized_general(XCSF *xcsf, CL *c1, CL *c2)
+{
+	// returns whether cond1 is more general than cond2
+	COND_QUANTIZED *cond1 = c1->cond;
+	COND_QUANTIZED *cond2 = c2->cond;
+	for(int i = 0; i < xcsf->num_x_vars; i++) {
+		if(cond1->lower[i] > cond2->lower[i]
+				|| cond1->upper[i] < cond2->upper[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void cond_quantized_print(XCSF *xcsf, CL *c)
+{
+	COND_QUANTIZED *cond = c->cond;
+	double scale = cond_quantized_scale(xcsf);
+	printf("quantized:");
+	for(int i = 0; i < xcsf->num_x_vars; i++) {
+		printf(" (%5f, ", xcsf->MIN_CON + cond->lower[i] / scale);
+		printf("%5f)", xcsf->MIN_CON + cond->upper[i] / scale);
+	}
+	printf("\n");
+}
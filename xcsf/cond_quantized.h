@@ -0,0 +1,55 @@
+ /*
+ * Copyright (C) 2019 Richard Preen <rpreen@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+_Bool cond_quantized_crossover(XCSF *xcsf, CL *c1, CL *c2);
+_Bool cond_quantized_equal(XCSF *xcsf, CL *c1, CL *c2);
+_Bool cond_quantized_general(XCSF *xcsf, CL *c1, CL *c2);
+_Bool cond_quantized_match(XCSF *xcsf, CL *c, double *x);
+_Bool cond_quantized_mutate(XCSF *xcsf, CL *c);
+_Bool cond_quantized_box(XCSF *xcsf, CL *c, double *lower, double *upper);
+void cond_quantized_copy(XCSF *xcsf, CL *to, CL *from);
+void cond_quantized_cover(XCSF *xcsf, CL *c, double *x);
+void cond_quantized_free(XCSF *xcsf, CL *c);
+void cond_quantized_init(XCSF *xcsf, CL *c);
+void cond_quantized_input(XCSF *xcsf, double *x, int rows);
+void cond_quantized_print(XCSF *xcsf, CL *c);
+void cond_quantized_rand(XCSF *xcsf, CL *c);
+void cond_quantized_reinit(XCSF *xcsf, CL *c);
+double cond_quantized_mu(XCSF *xcsf, CL *c, int m);
+size_t cond_quantized_bytes(XCSF *xcsf);
+size_t cond_quantized_heap(XCSF *xcsf, CL *c);
+uint64_t cond_quantized_hash(XCSF *xcsf, CL *c);
+
+static struct CondVtbl const cond_quantized_vtbl = {
+	&cond_quantized_crossover,
+	&cond_quantized_equal,
+	&cond_quantized_general,
+	&cond_quantized_match,
+	&cond_quantized_mutate,
+	&cond_quantized_box,
+	&cond_quantized_mu,
+	&cond_quantized_bytes,
+	&cond_quantized_heap,
+	&cond_quantized_hash,
+	&cond_quantized_copy,
+	&cond_quantized_cover,
+	&cond_quantized_free,
+	&cond_quantized_init,
+	&cond_quantized_print,
+	&cond_quantized_rand,
+	&cond_quantized_reinit
+};      
@@ -22,6 +22,9 @@
  * Provides functionality to create real-valued hyperrectangle conditions
  * whereby a classifier matches for a given problem instance if, and
  * only if, all of the current state variables fall within the area covered.
+ * Each condition also keeps the indices of its active variables, those not
+ * spanning all of [MIN_CON, MAX_CON], so that an input lying within that
+ * range is only compared on the variables the condition constrains.
  * Includes operations for copying, mutating, printing, etc.
  */
 
@@ -34,32 +37,119 @@
 #include "random.h"
 #include "cl.h"
 #include "cond_rectangle.h"
+#include "cl_index.h"
 
 typedef struct COND_RECTANGLE {
 	double *lower;
 	double *upper;
-	_Bool m;
 	double *mu;
+	int *act_var; // indices of the variables not spanning [MIN_CON, MAX_CON]
+	int num_active; // number of active variables
+	double act_min; // MIN_CON when the active variables were listed
+	double act_max; // MAX_CON when the active variables were listed
 } COND_RECTANGLE;
 
+void cond_rectangle_active(XCSF *xcsf, COND_RECTANGLE *cond);
 void cond_rectangle_bounds(XCSF *xcsf, double *l, double *u);
 
+// matches every variable for a number of input variables known at compile
+// time, so that the loop is unrolled; most conditions fail on an early variable
+#define COND_RECTANGLE_MATCH_DIM(n) \
+	_Bool cond_rectangle_match_##n(XCSF *xcsf, CL *c, double *x) \
+	{ \
+		(void)xcsf; \
+		COND_RECTANGLE *cond = c->cond; \
+		for(int i = 0; i < n; i++) { \
+			if(cond->lower[i] > x[i] || cond->upper[i] < x[i]) { \
+				return false; \
+			} \
+		} \
+		return true; \
+	}
+#define COND_RECTANGLE_MATCH_CASE(n) case n: return cond_rectangle_match_##n(xcsf, c, x);
+
+CL_FIXED_DIMS(COND_RECTANGLE_MATCH_DIM)
+
 void cond_rectangle_init(XCSF *xcsf, CL *c)
 {
-	COND_RECTANGLE *cond = malloc(sizeof(COND_RECTANGLE));
-	cond->lower = malloc(sizeof(double) * xcsf->num_x_vars);
-	cond->upper = malloc(sizeof(double) * xcsf->num_x_vars); 
-	c->cond = cond;
-	sam_init(xcsf, &cond->mu);
+	// the condition is stored within the classifier's memory block:
+	// [COND_RECTANGLE][lower][upper][mu][act_var]
+	COND_RECTANGLE *cond = c->cond;
+	cond->lower = (double *) (cond + 1);
+	cond->upper = cond->lower + xcsf->num_x_vars;
+	cond->mu = cond->upper + xcsf->num_x_vars;
+	cond->act_var = (int *) (cond->mu + xcsf->NUM_SAM);
+	cond->num_active = 0;
+	cond->act_min = NAN;
+	cond->act_max = NAN;
+	sam_reinit(xcsf, cond->mu);
 }
 
-void cond_rectangle_free(XCSF *xcsf, CL *c)
+size_t cond_rectangle_bytes(XCSF *xcsf)
+{
+	return sizeof(COND_RECTANGLE) + sizeof(double) * (2 * xcsf->num_x_vars + xcsf->NUM_SAM) +
+		sizeof(int) * xcsf->num_x_vars;
+}
+
+void cond_rectangle_active(XCSF *xcsf, COND_RECTANGLE *cond)
+{
+	// lists the variables that the condition constrains
+	cond->num_active = 0;
+	cond->act_min = xcsf->MIN_CON;
+	cond->act_max = xcsf->MAX_CON;
+	for(int i = 0; i < xcsf->num_x_vars; i++) {
+		if(cond->lower[i] > xcsf->MIN_CON || cond->upper[i] < xcsf->MAX_CON) {
+			cond->act_var[cond->num_active++] = i;
+		}
+	}
+}
+
+void cond_rectangle_input(XCSF *xcsf, double *x, int rows)
+{
+	// only inputs within [MIN_CON, MAX_CON] may skip the inactive variables
+	xcsf->x_span = x;
+	xcsf->x_span_rows = rows;
+	for(int i = 0; i < rows * xcsf->num_x_vars; i++) {
+		if(x[i] < xcsf->MIN_CON || x[i] > xcsf->MAX_CON) {
+			xcsf->x_span = NULL;
+			break;
+		}
+	}
+}
+
+size_t cond_rectangle_heap(XCSF *xcsf, CL *c)
+{
+	// stored within the classifier's memory block
+	(void)xcsf;
+	(void)c;
+	return 0;
+}
+
+uint64_t cond_rectangle_hash(XCSF *xcsf, CL *c)
+{
+	// lower and upper are contiguous
+	COND_RECTANGLE *cond = c->cond;
+	return hash_bytes(cond->lower, sizeof(double) * 2 * xcsf->num_x_vars, HASH_SEED);
+}
+
+_Bool cond_rectangle_equal(XCSF *xcsf, CL *c1, CL *c2)
+{
+	COND_RECTANGLE *cond1 = c1->cond;
+	COND_RECTANGLE *cond2 = c2->cond;
+	return memcmp(cond1->lower, cond2->lower, sizeof(double) * 2 * xcsf->num_x_vars) == 0;
+}
+
+void cond_rectangle_reinit(XCSF *xcsf, CL *c)
 {
 	COND_RECTANGLE *cond = c->cond;
-	free(cond->lower);
-	free(cond->upper);
-	sam_free(xcsf, cond->mu);
-	free(c->cond);
+	sam_reinit(xcsf, cond->mu);
+}
+
+void cond_rectangle_free(XCSF *xcsf, CL *c)
+{
+	// freed along with the classifier
+	(void)xcsf;
+	(void)c;
 }
 
 double cond_rectangle_mu(XCSF *xcsf, CL *c, int m)
@@ -73,9 +163,13 @@ void cond_rectangle_copy(XCSF *xcsf, CL *to, CL *from)
 {
 	COND_RECTANGLE *to_cond = to->cond;
 	COND_RECTANGLE *from_cond = from->cond;
-	memcpy(to_cond->lower, from_cond->lower, sizeof(double)*xcsf->num_x_vars);
-	memcpy(to_cond->upper, from_cond->upper, sizeof(double)*xcsf->num_x_vars);
-	sam_copy(xcsf, to_cond->mu, from_cond->mu);
+	// lower, upper, and mu are contiguous
+	memcpy(to_cond->lower, from_cond->lower, 
+			sizeof(double) * (2 * xcsf->num_x_vars + xcsf->NUM_SAM));
+	memcpy(to_cond->act_var, from_cond->act_var, sizeof(int) * from_cond->num_active);
+	to_cond->num_active = from_cond->num_active;
+	to_cond->act_min = from_cond->act_min;
+	to_cond->act_max = from_cond->act_max;
 }                             
 
 void cond_rectangle_rand(XCSF *xcsf, CL *c)
@@ -86,6 +180,7 @@ void cond_rectangle_rand(XCSF *xcsf, CL *c)
 		cond->upper[i] = ((xcsf->MAX_CON - xcsf->MIN_CON) * drand()) + xcsf->MIN_CON;
 		cond_rectangle_bounds(xcsf, &cond->lower[i], &cond->upper[i]);
 	}
+	cond_rectangle_active(xcsf, cond);
 }
 
 void cond_rectangle_bounds(XCSF *xcsf, double *l, double *u)
@@ -117,26 +212,36 @@ void cond_rectangle_cover(XCSF *xcsf, CL *c, double *x)
 		cond->upper[i] = x[i] + ((xcsf->MAX_CON - xcsf->MIN_CON) * drand() * 0.5);
 		cond_rectangle_bounds(xcsf, &cond->lower[i], &cond->upper[i]);
 	}
+	cond_rectangle_active(xcsf, cond);
 }
 
 _Bool cond_rectangle_match(XCSF *xcsf, CL *c, double *x)
 {
 	COND_RECTANGLE *cond = c->cond;
+	if(cond->num_active * 2 <= xcsf->num_x_vars
+			&& cond->act_min == xcsf->MIN_CON && cond->act_max == xcsf->MAX_CON
+			&& cl_input_row(xcsf, xcsf->x_span, xcsf->x_span_rows, x) >= 0) {
+		// the input lies within [MIN_CON, MAX_CON] and most variables are
+		// inactive, so only the active ones are compared; the variables are
+		// listed again once mutated if the range has since changed
+		for(int k = 0; k < cond->num_active; k++) {
+			int i = cond->act_var[k];
+			if(cond->lower[i] > x[i] || cond->upper[i] < x[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+	switch(xcsf->num_x_vars) {
+		CL_FIXED_DIMS(COND_RECTANGLE_MATCH_CASE)
+		default: break;
+	}
 	for(int i = 0; i < xcsf->num_x_vars; i++) {
 		if(cond->lower[i] > x[i] || cond->upper[i] < x[i]) {
-			cond->m = false;
 			return false;
 		}
 	}
-	cond->m = true;
-	return cond->m;
-}
-
-_Bool cond_rectangle_match_state(XCSF *xcsf, CL *c)
-{
-	(void)xcsf;
-	COND_RECTANGLE *cond = c->cond;
-	return cond->m;
+	return true;
 }
 
 _Bool cond_rectangle_crossover(XCSF *xcsf, CL *c1, CL *c2) 
@@ -164,6 +269,8 @@ _Bool cond_rectangle_crossover(XCSF *xcsf, CL *c1, CL *c2)
 			cond_rectangle_bounds(xcsf, &cond1->lower[i], &cond1->upper[i]);
 			cond_rectangle_bounds(xcsf, &cond2->lower[i], &cond2->upper[i]);
 		}
+		cond_rectangle_active(xcsf, cond1);
+		cond_rectangle_active(xcsf, cond2);
 	}
 	return changed;
 }
@@ -195,9 +302,19 @@ _Bool cond_rectangle_mutate(XCSF *xcsf, CL *c)
 		}
 		cond_rectangle_bounds(xcsf, &cond->lower[i], &cond->upper[i]);
 	}
+	cond_rectangle_active(xcsf, cond);
 	return changed;
 }
 
+_Bool cond_rectangle_box(XCSF *xcsf, CL *c, double *lower, double *upper)
+{
+	// the bounding box is the hyperrectangle itself
+	COND_RECTANGLE *cond = c->cond;
+	memcpy(lower, cond->lower, sizeof(double) * xcsf->num_x_vars);
+	memcpy(upper, cond->upper, sizeof(double) * xcsf->num_x_vars);
+	return true;
+}
+
 _Bool cond_rectangle_general(XCSF *xcsf, CL *c1, CL *c2)
 {
 	// returns whether cond1 is more general than cond2
@@ -16,29 +16,40 @@
  */
 
 _Bool cond_rectangle_crossover(XCSF *xcsf, CL *c1, CL *c2);
+_Bool cond_rectangle_equal(XCSF *xcsf, CL *c1, CL *c2);
 _Bool cond_rectangle_general(XCSF *xcsf, CL *c1, CL *c2);
 _Bool cond_rectangle_match(XCSF *xcsf, CL *c, double *x);
-_Bool cond_rectangle_match_state(XCSF *xcsf, CL *c);
 _Bool cond_rectangle_mutate(XCSF *xcsf, CL *c);
+_Bool cond_rectangle_box(XCSF *xcsf, CL *c, double *lower, double *upper);
 void cond_rectangle_copy(XCSF *xcsf, CL *to, CL *from);
 void cond_rectangle_cover(XCSF *xcsf, CL *c, double *x);
 void cond_rectangle_free(XCSF *xcsf, CL *c);
 void cond_rectangle_init(XCSF *xcsf, CL *c);
+void cond_rectangle_input(XCSF *xcsf, double *x, int rows);
 void cond_rectangle_print(XCSF *xcsf, CL *c);
 void cond_rectangle_rand(XCSF *xcsf, CL *c);
+void cond_rectangle_reinit(XCSF *xcsf, CL *c);
 double cond_rectangle_mu(XCSF *xcsf, CL *c, int m);
+size_t cond_rectangle_bytes(XCSF *xcsf);
+size_t cond_rectangle_heap(XCSF *xcsf, CL *c);
+uint64_t cond_rectangle_hash(XCSF *xcsf, CL *c);
 
 static struct CondVtbl const cond_rectangle_vtbl = {
 	&cond_rectangle_crossover,
+	&cond_rectangle_equal,
 	&cond_rectangle_general,
 	&cond_rectangle_match,
-	&cond_rectangle_match_state,
 	&cond_rectangle_mutate,
+	&cond_rectangle_box,
 	&cond_rectangle_mu,
+	&cond_rectangle_bytes,
+	&cond_rectangle_heap,
+	&cond_rectangle_hash,
 	&cond_rectangle_copy,
 	&cond_rectangle_cover,
 	&cond_rectangle_free,
 	&cond_rectangle_init,
 	&cond_rectangle_print,
-	&cond_rectangle_rand
+	&cond_rectangle_rand,
+	&cond_rectangle_reinit
 };      
@@ -0,0 +1,309 @@
+/*
+ * Copyright (C) 2019 Richard Preen <rpreen@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **************
+ * Description:
+ **************
+ * The ternary classifier condition module.
+ *
+ * Provides functionality to create ternary {0,1,#} conditions for binary
+ * inputs, where an input variable is 1 if it lies above the midpoint of
+ * [MIN_CON, MAX_CON]. Conditions are stored as bitmasks of the variables
+ * cared about and of their required values, 64 variables per word, so that
+ * matching, generality, crossover, and mutation operate on whole words. A
+ * classifier matches if, and only if, ((x ^ value) & care) == 0 for every
+ * word. The inputs of each trial are packed once for matching by every
+ * classifier. Includes operations for copying, mutating, printing, etc.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <math.h>
+#include "data_structures.h"
+#include "random.h"
+#include "mt64.h"
+#include "cl.h"
+#include "cond_ternary.h"
+#include "cl_index.h"
+
+typedef struct COND_TERNARY {
+	uint64_t *care; // bits of the variables that must match
+	uint64_t *value; // required values; zero where not cared about
+	double *mu;
+} COND_TERNARY;
+
+int cond_ternary_words(XCSF *xcsf);
+uint64_t cond_ternary_input(XCSF *xcsf, double *x, int w);
+uint64_t cond_ternary_mask(XCSF *xcsf, int w);
+
+void cond_ternary_init(XCSF *xcsf, CL *c)
+{
+	// the condition is stored within the classifier's memory block:
+	// [COND_TERNARY][care][value][mu]
+	COND_TERNARY *cond = c->cond;
+	int words = cond_ternary_words(xcsf);
+	cond->care = (uint64_t *) (cond + 1);
+	cond->value = cond->care + words;
+	cond->mu = (double *) (cond->value + words);
+	sam_reinit(xcsf, cond->mu);
+}
+
+size_t cond_ternary_bytes(XCSF *xcsf)
+{
+	return sizeof(COND_TERNARY) + sizeof(uint64_t) * 2 * cond_ternary_words(xcsf) +
+		sizeof(double) * xcsf->NUM_SAM;
+}
+
+size_t cond_ternary_heap(XCSF *xcsf, CL *c)
+{
+	// stored within the classifier's memory block
+	(void)xcsf;
+	(void)c;
+	return 0;
+}
+
+int cond_ternary_words(XCSF *xcsf)
+{
+	return (xcsf->num_x_vars + 63) / 64;
+}
+
+uint64_t cond_ternary_mask(XCSF *xcsf, int w)
+{
+	// bits of word w that correspond to input variables
+	int bits = xcsf->num_x_vars - w * 64;
+	return bits >= 64 ? ~0ULL : (1ULL << bits) - 1;
+}
+
+uint64_t cond_ternary_input(XCSF *xcsf, double *x, int w)
+{
+	// packs the binary values of the input variables of word w
+	double mid = (xcsf->MIN_CON + xcsf->MAX_CON) * 0.5;
+	int start = w * 64;
+	int end = start + 64 < xcsf->num_x_vars ? start + 64 : xcsf->num_x_vars;
+	uint64_t bits = 0;
+	for(int i = start; i < end; i++) {
+		bits |= (uint64_t) (x[i] > mid) << (i - start);
+	}
+	return bits;
+}
+
+void cond_ternary_pack(XCSF *xcsf, double *x, int rows)
+{
+	// packs inputs once for matching by every classifier
+	int words = cond_ternary_words(xcsf);
+	if(xcsf->tx == NULL || xcsf->tx_size < rows) {
+		xcsf->tx_size = rows;
+		xcsf->tx = realloc(xcsf->tx, sizeof(uint64_t) * rows * words);
+	}
+	for(int r = 0; r < rows; r++) {
+		for(int w = 0; w < words; w++) {
+			xcsf->tx[r * words + w] = cond_ternary_input(xcsf, &x[r * xcsf->num_x_vars], w);
+		}
+	}
+	xcsf->tx_src = x;
+	xcsf->tx_rows = rows;
+}
+
+uint64_t cond_ternary_hash(XCSF *xcsf, CL *c)
+{
+	// care and value are contiguous
+	COND_TERNARY *cond = c->cond;
+	return hash_bytes(cond->care, sizeof(uint64_t) * 2 * cond_ternary_words(xcsf), HASH_SEED);
+}
+
+_Bool cond_ternary_equal(XCSF *xcsf, CL *c1, CL *c2)
+{
+	COND_TERNARY *cond1 = c1->cond;
+	COND_TERNARY *cond2 = c2->cond;
+	return memcmp(cond1->care, cond2->care, sizeof(uint64_t) * 2 * cond_ternary_words(xcsf)) == 0;
+}
+
+void cond_ternary_reinit(XCSF *xcsf, CL *c)
+{
+	COND_TERNARY *cond = c->cond;
+	sam_reinit(xcsf, cond->mu);
+}
+
+void cond_ternary_free(XCSF *xcsf, CL *c)
+{
+	// freed along with the classifier
+	(void)xcsf;
+	(void)c;
+}
+
+double cond_ternary_mu(XCSF *xcsf, CL *c, int m)
+{
+	(void)xcsf;
+	COND_TERNARY *cond = c->cond;
+	return cond->mu[m];
+}
+
+void cond_ternary_copy(XCSF *xcsf, CL *to, CL *from)
+{
+	COND_TERNARY *to_cond = to->cond;
+	COND_TERNARY *from_cond = from->cond;
+	// care, value, and mu are contiguous
+	memcpy(to_cond->care, from_cond->care,
+			sizeof(uint64_t) * 2 * cond_ternary_words(xcsf) + sizeof(double) * xcsf->NUM_SAM);
+}
+
+void cond_ternary_rand(XCSF *xcsf, CL *c)
+{
+	COND_TERNARY *cond = c->cond;
+	for(int w = 0; w < cond_ternary_words(xcsf); w++) {
+		cond->care[w] = genrand64_int64() & cond_ternary_mask(xcsf, w);
+		cond->value[w] = genrand64_int64() & cond->care[w];
+	}
+}
+
+void cond_ternary_cover(XCSF *xcsf, CL *c, double *x)
+{
+	// cares about each input variable with probability 1 - P_DONTCARE
+	COND_TERNARY *cond = c->cond;
+	for(int w = 0; w < cond_ternary_words(xcsf); w++) {
+		cond->care[w] = 0;
+		int bits = w * 64 + 64 < xcsf->num_x_vars ? 64 : xcsf->num_x_vars - w * 64;
+		for(int i = 0; i < bits; i++) {
+			if(drand() >= xcsf->P_DONTCARE) {
+				cond->care[w] |= 1ULL << i;
+			}
+		}
+		cond->value[w] = cond_ternary_input(xcsf, x, w) & cond->care[w];
+	}
+}
+
+_Bool cond_ternary_match(XCSF *xcsf, CL *c, double *x)
+{
+	COND_TERNARY *cond = c->cond;
+	int words = cond_ternary_words(xcsf);
+	int row = cl_input_row(xcsf, xcsf->tx_src, xcsf->tx_rows, x);
+	if(row < 0) {
+		// the input was not packed for this trial
+		for(int w = 0; w < words; w++) {
+			if(((cond_ternary_input(xcsf, x, w) ^ cond->value[w]) & cond->care[w]) != 0) {
+				return false;
+			}
+		}
+		return true;
+	}
+	const uint64_t *bits = &xcsf->tx[row * words];
+	for(int w = 0; w < words; w++) {
+		if(((bits[w] ^ cond->value[w]) & cond->care[w]) != 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+_Bool cond_ternary_crossover(XCSF *xcsf, CL *c1, CL *c2)
+{
+	COND_TERNARY *cond1 = c1->cond;
+	COND_TERNARY *cond2 = c2->cond;
+	_Bool changed = false;
+	// uniform crossover swapping the alleles selected by a random mask
+	if(drand() < xcsf->P_CROSSOVER) {
+		for(int w = 0; w < cond_ternary_words(xcsf); w++) {
+			uint64_t mask = genrand64_int64();
+			uint64_t care = (cond1->care[w] ^ cond2->care[w]) & mask;
+			uint64_t value = (cond1->value[w] ^ cond2->value[w]) & mask;
+			cond1->care[w] ^= care;
+			cond2->care[w] ^= care;
+			cond1->value[w] ^= value;
+			cond2->value[w] ^= value;
+			if(care != 0 || value != 0) {
+				changed = true;
+			}
+		}
+	}
+	return changed;
+}
+
+_Bool cond_ternary_mutate(XCSF *xcsf, CL *c)
+{
+	COND_TERNARY *cond = c->cond;
+	_Bool changed = false;
+	// adapt mutation rates
+	if(xcsf->NUM_SAM > 0) {
+		sam_adapt(xcsf, cond->mu);
+		xcsf->P_MUTATION = cond->mu[0];
+	}
+	if(xcsf->P_MUTATION <= 0.0) {
+		return false;
+	}
+	// visits the mutated alleles by drawing the geometric gaps between them;
+	// a cared about allele becomes a don't care and vice versa
+	double log_q = log(1.0 - xcsf->P_MUTATION);
+	int i = -1;
+	while(true) {
+		double gap = xcsf->P_MUTATION < 1.0 ? log(1.0 - drand()) / log_q : 0.0;
+		i += 1 + (int) fmin(gap, xcsf->num_x_vars);
+		if(i >= xcsf->num_x_vars) {
+			break;
+		}
+		uint64_t bit = 1ULL << (i % 64);
+		cond->care[i / 64] ^= bit;
+		cond->value[i / 64] &= ~bit;
+		if((cond->care[i / 64] & bit) && drand() < 0.5) {
+			cond->value[i / 64] |= bit;
+		}
+		changed = true;
+	}
+	return changed;
+}
+
+_Bool cond_ternary_box(XCSF *xcsf, CL *c, double *lower, double *upper)
+{
+	// matched through bitmasks rather than a bounding box
+	(void)xcsf;
+	(void)c;
+	(void)lower;
+	(void)upper;
+	return false;
+}
+
+_Bool cond_ternary_general(XCSF *xcsf, CL *c1, CL *c2)
+{
+	// returns whether cond1 is more general than cond2: it cares about no
+	// variable that cond2 does not, and requires the same values
+	COND_TERNARY *cond1 = c1->cond;
+	COND_TERNARY *cond2 = c2->cond;
+	for(int w = 0; w < cond_ternary_words(xcsf); w++) {
+		if((cond1->care[w] & ~cond2->care[w]) != 0
+				|| ((cond1->value[w] ^ cond2->value[w]) & cond1->care[w]) != 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void cond_ternary_print(XCSF *xcsf, CL *c)
+{
+	COND_TERNARY *cond = c->cond;
+	printf("ternary: ");
+	for(int i = 0; i < xcsf->num_x_vars; i++) {
+		uint64_t bit = 1ULL << (i % 64);
+		if(!(cond->care[i / 64] & bit)) {
+			printf("#");
+		}
+		else {
+			printf("%d", (cond->value[i / 64] & bit) ? 1 : 0);
+		}
+	}
+	printf("\n");
+}
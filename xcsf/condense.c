@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2015--2019 Richard Preen <rpreen@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **************
+ * Description: 
+ **************
+ * The population condensation module.
+ *
+ * Compacts a trained population for cheaper inference. Neither covering nor
+ * the genetic algorithm is performed. For each input, the accurate and
+ * experienced matching classifier with the lowest error is retained. Inputs
+ * matched by no such classifier instead retain the best inaccurate match,
+ * preferring those with at least THETA_SUB experience, so that every input
+ * matched before condensation remains matched; these inputs are counted in
+ * the condensation report. Accurate and experienced survivors then subsume
+ * any more specific survivors, absorbing their numerosity.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "data_structures.h"
+#include "cl.h"
+#include "cl_set.h"
+#include "pool.h"
+#include "cl_batch.h"
+#include "condense.h"
+
+_Bool condense_better(XCSF *xcsf, CL *c, CL *best);
+void condense_merge(XCSF *xcsf);
+int condense_select(XCSF *xcsf, INPUT *data);
+
+int condense(XCSF *xcsf, INPUT *data)
+{
+	// returns the number of inputs that retained an inaccurate classifier
+	int inaccurate = condense_select(xcsf, data);
+	condense_merge(xcsf);
+	return inaccurate;
+}
+
+int condense_select(XCSF *xcsf, INPUT *data)
+{
+	// removes the classifiers that are not the best match for any input;
+	// returns the number of inputs with no accurate match
+	SET *pset = &xcsf->pset;
+	if(pset->size == 0) {
+		return 0;
+	}
+	SET *mset = &xcsf->mset;
+	int inaccurate = 0;
+	_Bool *keep = calloc(pset->size, sizeof(_Bool));
+	// the inputs are matched in batches
+	int words = batch_words(xcsf);
+	uint64_t *bits = malloc(sizeof(uint64_t) * words * BATCH_ROWS);
+	for(int row = 0; row < data->rows; row++) {
+		if(row % BATCH_ROWS == 0) {
+			int n = data->rows - row < BATCH_ROWS ? data->rows - row : BATCH_ROWS;
+			batch_match(xcsf, &data->x[row * data->x_cols], n, bits);
+		}
+		batch_set(xcsf, &bits[(row % BATCH_ROWS) * words], mset);
+		CL *best = NULL;
+		_Bool best_acc = false;
+		for(int i = 0; i < mset->size; i++) {
+			CL *c = mset->list[i];
+			// accurate classifiers are always preferred
+			_Bool acc = cl_subsumer(xcsf, c);
+			if(best == NULL || (acc && !best_acc)
+					|| (acc == best_acc && condense_better(xcsf, c, best))) {
+				best = c;
+				best_acc = acc;
+			}
+		}
+		set_clear(xcsf, mset);
+		if(best != NULL) {
+			keep[best->pos] = true;
+			inaccurate += !best_acc;
+		}
+	}
+	// removal moves the last classifier into the freed slot
+	for(int i = pset->size-1; i >= 0; i--) {
+		if(!keep[i]) {
+			CL *c = pset->list[i];
+			pop_remove(xcsf, c);
+			pool_put(xcsf, c);
+		}
+	}
+	free(bits);
+	free(keep);
+	return inaccurate;
+}
+
+_Bool condense_better(XCSF *xcsf, CL *c, CL *best)
+{
+	// experienced classifiers are preferred, then those with lower error
+	_Bool c_exp = c->exp >= xcsf->THETA_SUB;
+	_Bool best_exp = best->exp >= xcsf->THETA_SUB;
+	if(c_exp != best_exp) {
+		return c_exp;
+	}
+	if(c->err != best->err) {
+		return c->err < best->err;
+	}
+	return c->num > best->num;
+}
+
+void condense_merge(XCSF *xcsf)
+{
+	// merges survivors into a more general accurate survivor
+	SET *pset = &xcsf->pset;
+	int i = 0;
+	while(i < pset->size) {
+		CL *c = pset->list[i];
+		CL *s = NULL;
+		for(int j = 0; j < pset->size; j++) {
+			CL *o = pset->list[j];
+			if(o != c && cl_subsumer(xcsf, o) && cl_general(xcsf, o, c)) {
+				s = o;
+				break;
+			}
+		}
+		if(s != NULL) {
+			s->num += c->num;
+			c->num = 0;
+			pop_remove(xcsf, c);
+			pop_update_cl(xcsf, s);
+			pool_put(xcsf, c);
+		}
+		else {
+			i++;
+		}
+	}
+}
+
+double condense_error(XCSF *xcsf, INPUT *data)
+{
+	// returns the mean squared error of the system prediction over the
+	// inputs matched by the population, without covering
+	SET *mset = &xcsf->mset;
+	double pred[xcsf->num_y_vars];
+	double error = 0.0;
+	int matched = 0;
+	int words = batch_words(xcsf);
+	uint64_t *bits = NULL;
+	if(batch_pred(xcsf) && words > 0) {
+		bits = malloc(sizeof(uint64_t) * words * BATCH_ROWS);
+	}
+	for(int row = 0; row < data->rows; row++) {
+		double *x = &data->x[row * data->x_cols];
+		double *y = &data->y[row * data->y_cols];
+		if(bits != NULL) {
+			// the inputs are matched in batches
+			if(row % BATCH_ROWS == 0) {
+				int n = data->rows - row < BATCH_ROWS ? data->rows - row : BATCH_ROWS;
+				batch_match(xcsf, x, n, bits);
+			}
+			batch_set(xcsf, &bits[(row % BATCH_ROWS) * words], mset);
+		}
+		else {
+			cl_input(xcsf, x, 1);
+			for(int i = 0; i < xcsf->pset.size; i++) {
+				if(cl_match(xcsf, xcsf->pset.list[i], x)) {
+					set_add(xcsf, mset, xcsf->pset.list[i]);
+				}
+			}
+		}
+		if(mset->size > 0) {
+			set_pred(xcsf, mset, x, pred);
+			double mse = 0.0;
+			for(int var = 0; var < xcsf->num_y_vars; var++) {
+				mse += (y[var]-pred[var])*(y[var]-pred[var]);
+			}
+			error += mse / xcsf->num_y_vars;
+			matched++;
+		}
+		set_clear(xcsf, mset);
+	}
+	free(bits);
+	if(matched == 0) {
+		return 0.0;
+	}
+	return error / matched;
+}
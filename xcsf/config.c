@@ -50,6 +50,8 @@ void constants_init(XCSF *xcsf, const char *filename)
 	xcsf->COND_TYPE = atoi(getvalue("COND_TYPE"));
 	xcsf->PRED_TYPE = atoi(getvalue("PRED_TYPE"));
 	xcsf->POP_SIZE = atoi(getvalue("POP_SIZE"));
+	xcsf->MAX_POP_BYTES = (size_t) atof(getvalue("MAX_POP_BYTES"));
+	xcsf->MATCH_CACHE_BYTES = (size_t) atof(getvalue("MATCH_CACHE_BYTES"));
 	if(strcmp(getvalue("POP_INIT"), "false") == 0) {
 		xcsf->POP_INIT = false;
 	}
@@ -60,6 +62,7 @@ void constants_init(XCSF *xcsf, const char *filename)
 	xcsf->P_CROSSOVER = atof(getvalue("P_CROSSOVER"));
 	xcsf->P_MUTATION = atof(getvalue("P_MUTATION"));
 	xcsf->THETA_SUB = atof(getvalue("THETA_SUB"));
+	xcsf->SIG_SAMPLES = atoi(getvalue("SIG_SAMPLES"));
 	xcsf->EPS_0 = atof(getvalue("EPS_0"));
 	xcsf->DELTA = atof(getvalue("DELTA"));
 	xcsf->THETA_DEL = atof(getvalue("THETA_DEL"));
@@ -95,6 +98,8 @@ void constants_init(XCSF *xcsf, const char *filename)
 	xcsf->S_MUTATION = atof(getvalue("S_MUTATION"));
 	xcsf->MIN_CON = atof(getvalue("MIN_CON"));
 	xcsf->MAX_CON = atof(getvalue("MAX_CON"));
+	xcsf->P_DONTCARE = atof(getvalue("P_DONTCARE"));
+	xcsf->THETA_ENV = atoi(getvalue("THETA_ENV"));
 	xcsf->NUM_HIDDEN_NEURONS = atoi(getvalue("NUM_HIDDEN_NEURONS"));
 	xcsf->HIDDEN_NEURON_ACTIVATION = atoi(getvalue("HIDDEN_NEURON_ACTIVATION"));
 	xcsf->DGP_NUM_NODES = atoi(getvalue("DGP_NUM_NODES"));
@@ -21,6 +21,9 @@
  * XCSF data structures
  */
 
+#include <stddef.h>
+#include <stdint.h>
+
 // classifier data structure
 typedef struct CL {
 	struct CondVtbl const *cond_vptr; // functions acting on conditions
@@ -33,19 +36,125 @@ typedef struct CL {
 	int exp;
 	double size;
 	int time;
+	int pos; // index in the population set list
+	uint64_t hash; // condition hash while in the population index
+	size_t mem; // bytes of memory used while in the population
+	struct RT_NODE *leaf; // spatial index leaf while in the population index
+	double *env; // lower then upper bounds of the training inputs matched, or NULL
+	int env_size; // training inputs the envelope has been grown to contain
+	int env_rejects; // inputs rejected by the envelope without evaluating the condition
+	int env_passes; // inputs within the envelope passed on to the condition
+	long id; // unique identifier assigned when added to the population
+	uint64_t *sig; // reference inputs matched by the condition, or NULL
+	int sig_epoch; // reference inputs the signature was computed for; 0 if none
+	int sig_words; // number of words in sig
+	size_t block; // bytes of the memory block allocated by cl_alloc()
 } CL;
 
-// classifier linked list node
-typedef struct NODE {
-	CL *cl;
-	struct NODE *next;
-} NODE;
+// classifier set
+typedef struct SET {
+	CL **list; // contiguous array of classifier pointers
+	int size; // number of macro-classifiers in the set
+	int num; // the total numerosity of the set
+	int capacity; // allocated length of the list
+} SET;
+
+// binary sum tree
+typedef struct SUM_TREE {
+	double *node; // node[1] is the root; leaves start at node[capacity]
+	int capacity; // number of leaves
+} SUM_TREE;
+
+// open addressing hash table of classifiers keyed by condition
+typedef struct CL_INDEX {
+	CL **slot; // classifier in each slot or NULL if empty
+	int capacity; // number of slots; a power of two
+	int size; // number of classifiers indexed
+} CL_INDEX;
+
+// R-tree of classifiers keyed by the bounding box of their condition
+typedef struct RTREE {
+	struct RT_NODE *root; // NULL until the first classifier is indexed
+	int dim; // number of dimensions of each box
+	int size; // number of classifiers indexed
+} RTREE;
+
+// dimension-major store of the condition bounding boxes of the population
+typedef struct BOXES {
+	double *lower; // lower bound of dimension d for slot i at [d * capacity + i]
+	double *upper; // upper bounds in the same layout
+	uint64_t *bits; // match bitmap of the slots
+	int dim; // number of dimensions of each box
+	int capacity; // slots per dimension; a multiple of 64
+	int size; // number of boxes stored; slot i is population position i
+	_Bool valid; // whether every population classifier has its box stored
+} BOXES;
+
+// classifier recorded as matching a cached input
+typedef struct MC_ITEM {
+	CL *c;
+	long id; // identifier of the classifier when recorded
+} MC_ITEM;
+
+// classifiers matching a cached input
+typedef struct MC_ROW {
+	MC_ITEM *item; // matching classifiers, or NULL if not cached
+	int size; // number of classifiers recorded
+	int capacity; // allocated length of item
+	int stamp; // insertion log length when last brought up to date
+	_Bool ref; // used since last passed by the eviction hand
+} MC_ROW;
+
+// classifiers matching each training input
+typedef struct MCACHE {
+	double *x; // training inputs cached, or NULL if disabled
+	int rows; // number of training inputs
+	MC_ROW *row; // cached classifiers of each training input
+	MC_ITEM *log; // classifiers added to the population in order
+	int log_size; // number of classifiers logged
+	int log_capacity; // maximum classifiers logged before clearing the cache
+	size_t bytes; // memory used by the cached classifiers
+	int hand; // next row visited by the eviction hand
+} MCACHE;
 
 // xcsf data structure
 typedef struct XCSF {
-	NODE *pset; // linked list of classifiers
-	int pop_num; // number of macro-classifiers in the population
-	int pop_num_sum; // the total population numerosity
+	SET pset; // population set
+	SET mset; // match set of the current trial
+	SET kset; // kill set of the current trial
+	SET pool; // deleted classifiers retained for reuse
+	SUM_TREE del_tree; // upper bounds of the population deletion votes
+	SUM_TREE fit_tree; // fitnesses of the population classifiers
+	double del_avg_fit; // mean fitness assumed by the deletion vote bounds
+	double *mu_sum; // population sums of each self-adaptive mutation rate
+	int mu_len; // number of mutation rates summed in mu_sum
+	CL_INDEX pop_index; // population classifiers by condition
+	RTREE pop_rtree; // population classifiers by condition bounding box
+	BOXES pop_boxes; // population condition bounding boxes for SIMD matching
+	struct CondVtbl const *pop_cond_vptr; // condition functions of the population
+	struct PredVtbl const *pop_pred_vptr; // prediction functions of the population
+	int pop_mixed; // population classifiers using other functions than these
+	size_t pop_bytes; // memory used by the population classifiers
+	long next_id; // identifier of the next classifier added to the population
+	MCACHE mcache; // classifiers matching each training input while fitting
+	double *sig_x; // reference inputs of the match signatures
+	int sig_rows; // number of reference inputs
+	int sig_epoch; // incremented whenever the reference inputs change
+	long env_rejects; // envelope rejects of the classifiers removed from the population
+	long env_passes; // envelope passes of the classifiers removed from the population
+	long covers; // classifiers created by covering
+	long cover_tries; // random conditions generated while covering
+	long cover_built; // covering conditions constructed after COVER_TRIES failed
+	uint16_t *qx; // current inputs quantized for matching
+	int qx_size; // number of inputs qx can hold
+	double *qx_src; // inputs that qx was quantized from
+	int qx_rows; // number of inputs quantized
+	uint64_t *tx; // current inputs packed into ternary words for matching
+	int tx_size; // number of inputs tx can hold
+	double *tx_src; // inputs that tx was packed from
+	int tx_rows; // number of inputs packed
+	double *x_span; // current inputs when they lie within [MIN_CON, MAX_CON]
+	int x_span_rows; // number of inputs at x_span
 	int time; // current number of executed trials
 
 	// experiment parameters
@@ -54,6 +163,8 @@ typedef struct XCSF {
 	int MAX_TRIALS; // number of problem instances to run in one experiment
 	int PERF_AVG_TRIALS; // number of problem instances to average performance output
 	int POP_SIZE; // maximum number of macro-classifiers in the population
+	size_t MAX_POP_BYTES; // maximum memory used by the population classifiers (0=unlimited)
+	size_t MATCH_CACHE_BYTES; // maximum memory used to cache the classifiers matching each training input (0=disabled)
 
 	// classifier parameters
 	double ALPHA; // linear coefficient used in calculating classifier accuracy
@@ -82,6 +193,8 @@ typedef struct XCSF {
 	// classifier condition parameters
 	double MAX_CON; // maximum value of a hyperrectangle interval
 	double MIN_CON; // minimum value of a hyperrectangle interval
+	double P_DONTCARE; // probability of a ternary condition bit being a don't care
+	int THETA_ENV; // experience after which neural, GP, and DGP conditions reject inputs outside their envelope (0=disabled)
 	double S_MUTATION; // maximum amount to mutate an allele
 	int NUM_HIDDEN_NEURONS; // number of hidden neurons to perform matching condition
 	int HIDDEN_NEURON_ACTIVATION; // activation function for the hidden layer
@@ -100,6 +213,7 @@ typedef struct XCSF {
 	_Bool GA_SUBSUMPTION; // whether to try and subsume offspring classifiers
 	_Bool SET_SUBSUMPTION; // whether to perform match set subsumption
 	double THETA_SUB; // minimum experience of a classifier to become a subsumer
+	int SIG_SAMPLES; // training inputs whose matches decide the generality of neural, GP, and DGP conditions (0=disabled)
 
 	// set by environment
 	int num_x_vars; // number of problem input variables
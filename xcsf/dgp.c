@@ -25,6 +25,7 @@
 #include "data_structures.h"
 #include "random.h"
 #include "dgp.h"
+#include "cl_index.h"
 
 void node_add(XCSF *xcsf, GRAPH *dgp, GNODE *new);
 void node_free(XCSF *xcsf, GNODE *node);
@@ -57,6 +58,39 @@ void graph_rand(XCSF *xcsf, GRAPH *dgp)
 	}
 }
 
+void graph_cover(XCSF *xcsf, GRAPH *dgp, double *x, double min)
+{
+	// rewires the first node to apply sin, cos, or tanh to a single input so
+	// that its state after updating with x is above min; the node holds a
+	// constant maximum state if no input allows this
+	GNODE *node = &dgp->nodes[0];
+	int func = -1;
+	int conn = 0;
+	int n = 0;
+	// choose uniformly among the candidates
+	for(int i = 0; i < xcsf->num_x_vars; i++) {
+		for(int f = 4; f < NUM_FUNC; f++) {
+			double state = 0.0;
+			node_update(xcsf, &state, f, x[i]);
+			if(state > min && irand(0, ++n) == 0) {
+				func = f;
+				conn = -(i+1);
+			}
+		}
+	}
+	for(int k = 0; k < MAX_K; k++) {
+		node->conn[k] = 0;
+	}
+	node->k = 0;
+	if(func < 0) {
+		node->initial_state = 1.0;
+		return;
+	}
+	node->func = func;
+	node->conn[0] = conn;
+	node->k = 1;
+}
+
 void graph_update(XCSF *xcsf, GRAPH *dgp, double *inputs)
 {
 	graph_reset(xcsf, dgp);
@@ -80,9 +114,15 @@ void graph_update(XCSF *xcsf, GRAPH *dgp, double *inputs)
 
 void graph_init(XCSF *xcsf, GRAPH *dgp, int n)
 {
-	dgp->t = irand(0,MAX_T)+1;
 	dgp->n = n;
 	dgp->nodes = malloc(sizeof(GNODE)*dgp->n);
+	graph_reinit(xcsf, dgp);
+}
+
+void graph_reinit(XCSF *xcsf, GRAPH *dgp)
+{
+	// randomises the number of cycles and the nodes of an allocated graph
+	dgp->t = irand(0,MAX_T)+1;
 	graph_rand(xcsf, dgp);
 }
 
@@ -90,12 +130,52 @@ void graph_copy(XCSF *xcsf, GRAPH *to, GRAPH *from)
 {
 	(void)xcsf;
 	to->t = from->t;
-	to->n = from->n;
-	free(to->nodes);
-	to->nodes = malloc(sizeof(GNODE)*from->n);
+	// reuse the existing nodes when the graphs are the same size
+	if(to->n != from->n) {
+		free(to->nodes);
+		to->nodes = malloc(sizeof(GNODE)*from->n);
+		to->n = from->n;
+	}
 	memcpy(to->nodes, from->nodes, sizeof(GNODE)*from->n);
 }
 
+size_t graph_heap(XCSF *xcsf, GRAPH *dgp)
+{
+	(void)xcsf;
+	return sizeof(GNODE) * dgp->n;
+}
+
+uint64_t graph_hash(XCSF *xcsf, GRAPH *dgp)
+{
+	// hashes the fields that define the graph; node states are transient
+	(void)xcsf;
+	uint64_t h = hash_bytes(&dgp->t, sizeof(int), HASH_SEED);
+	for(int i = 0; i < dgp->n; i++) {
+		GNODE *node = &dgp->nodes[i];
+		h = hash_bytes(node->conn, sizeof(int)*MAX_K, h);
+		h = hash_bytes(&node->initial_state, sizeof(double), h);
+		h = hash_bytes(&node->func, sizeof(int), h);
+	}
+	return h;
+}
+
+_Bool graph_equal(XCSF *xcsf, GRAPH *a, GRAPH *b)
+{
+	(void)xcsf;
+	if(a->t != b->t || a->n != b->n) {
+		return false;
+	}
+	for(int i = 0; i < a->n; i++) {
+		GNODE *na = &a->nodes[i];
+		GNODE *nb = &b->nodes[i];
+		if(na->func != nb->func || na->initial_state != nb->initial_state ||
+				memcmp(na->conn, nb->conn, sizeof(int)*MAX_K) != 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
 void node_copy(XCSF *xcsf, GNODE *to, GNODE *from)
 {
 	(void)xcsf;
@@ -37,10 +37,15 @@ typedef struct GRAPH {
 } GRAPH;
 
 void graph_init(XCSF *xcsf, GRAPH *dgp, int n);
+void graph_reinit(XCSF *xcsf, GRAPH *dgp);
 void graph_free(XCSF *xcsf, GRAPH *dgp);
 void graph_rand(XCSF *xcsf, GRAPH *dgp);
+void graph_cover(XCSF *xcsf, GRAPH *dgp, double *x, double min);
 void graph_print(XCSF *xcsf, GRAPH *dgp);
 void graph_copy(XCSF *xcsf, GRAPH *to, GRAPH *from);
+_Bool graph_equal(XCSF *xcsf, GRAPH *a, GRAPH *b);
+uint64_t graph_hash(XCSF *xcsf, GRAPH *dgp);
+size_t graph_heap(XCSF *xcsf, GRAPH *dgp);
 _Bool graph_mutate(XCSF *xcsf, GRAPH *dgp, double rate);
 void graph_update(XCSF *xcsf, GRAPH *dgp, double *inputs);
 double graph_output(XCSF *xcsf, GRAPH *dgp, int i);
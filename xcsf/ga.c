@@ -22,7 +22,8 @@
  * Selects parents to create offspring via crossover and mutation, and inserts
  * the newly created classifiers into the population. The maximum population
  * size limit is then enforced by deleting excess classifiers from the
- * population. Performs GA subsumption if enabled.
+ * population. Performs GA subsumption if enabled. Offspring with conditions
+ * identical to an existing classifier are merged into it.
  */
 
 #include <stdio.h>
@@ -33,27 +34,29 @@
 #include "random.h"
 #include "cl.h"
 #include "cl_set.h"    
+#include "pool.h"
 #include "ga.h"
 
-CL *ga_select_parent(XCSF *xcsf, NODE **set, double fit_sum);
-void ga_subsume(XCSF *xcsf, CL *c, CL *c1p, CL *c2p, NODE **set, int size);
+void ga_add(XCSF *xcsf, CL *c);
+CL *ga_select_parent(XCSF *xcsf, SET *mset, double fit_sum);
+void ga_subsume(XCSF *xcsf, CL *c, CL *c1p, CL *c2p, SET *mset);
 
-void ga(XCSF *xcsf, NODE **set, int size, int num, NODE **kset)
+void ga(XCSF *xcsf, SET *mset, SET *kset)
 {
 	// check if the genetic algorithm should be run
-	if(size == 0 || xcsf->time - set_mean_time(xcsf, set, num) < xcsf->THETA_GA) {
+	if(mset->size == 0 || xcsf->time - set_mean_time(xcsf, mset) < xcsf->THETA_GA) {
 		return;
 	}
-	set_times(xcsf, set);
+	set_times(xcsf, mset);
 	// select parents
-	double fit_sum = set_total_fit(xcsf, set);
-	CL *c1p = ga_select_parent(xcsf, set, fit_sum);
-	CL *c2p = ga_select_parent(xcsf, set, fit_sum);
+	double fit_sum = set_total_fit(xcsf, mset);
+	CL *c1p = ga_select_parent(xcsf, mset, fit_sum);
+	CL *c2p = ga_select_parent(xcsf, mset, fit_sum);
 
 	for(int i = 0; i < xcsf->THETA_OFFSPRING/2; i++) {
 		// create copies of parents
-		CL *c1 = malloc(sizeof(CL));
-		CL *c2 = malloc(sizeof(CL));
+		CL *c1 = pool_get(xcsf, c1p->size, c1p->time);
+		CL *c2 = pool_get(xcsf, c2p->size, c2p->time);
 		cl_copy(xcsf, c1, c1p);
 		cl_copy(xcsf, c2, c2p);
 		// reduce offspring err, fit
@@ -72,77 +75,99 @@ void ga(XCSF *xcsf, NODE **set, int size, int num, NODE **kset)
 			// c1 no crossover or mutation changes
 			if(!cmod && !m1mod) {
 				c1p->num++;
-				xcsf->pop_num_sum++;
-				cl_free(xcsf, c1);      
+				xcsf->pset.num++;
+				pop_update_cl(xcsf, c1p);
+				pool_put(xcsf, c1);      
 			}
 			else {
-				ga_subsume(xcsf, c1, c1p, c2p, set, size);
+				ga_subsume(xcsf, c1, c1p, c2p, mset);
 			}
 			// c2 no crossover or mutation changes
  			if(!cmod && !m2mod) {
 				c2p->num++;
-				xcsf->pop_num_sum++;
-				cl_free(xcsf, c2);      
+				xcsf->pset.num++;
+				pop_update_cl(xcsf, c2p);
+				pool_put(xcsf, c2);      
 			}
 			else {
-				ga_subsume(xcsf, c2, c1p, c2p, set, size);
+				ga_subsume(xcsf, c2, c1p, c2p, mset);
 			}    
 		}
 		else {
-			pop_add(xcsf, c1);
-			pop_add(xcsf, c2);
+			ga_add(xcsf, c1);
+			ga_add(xcsf, c2);
 		}
 	}
 	pop_enforce_limit(xcsf, kset);
 }   
 
-void ga_subsume(XCSF *xcsf, CL *c, CL *c1p, CL *c2p, NODE **set, int size)
+void ga_subsume(XCSF *xcsf, CL *c, CL *c1p, CL *c2p, SET *mset)
 {
 	// check if either parent subsumes the offspring
 	if(cl_subsumer(xcsf, c1p) && cl_general(xcsf, c1p, c)) {
 		c1p->num++;
-		xcsf->pop_num_sum++;
-		cl_free(xcsf, c);
+		xcsf->pset.num++;
+		pop_update_cl(xcsf, c1p);
+		pool_put(xcsf, c);
 	}
 	else if(cl_subsumer(xcsf, c2p) && cl_general(xcsf, c2p, c)) {
 		c2p->num++;
-		xcsf->pop_num_sum++;
-		cl_free(xcsf, c);
+		xcsf->pset.num++;
+		pop_update_cl(xcsf, c2p);
+		pool_put(xcsf, c);
 	}
 	// attempt to find a random subsumer from the set
 	else {
-		NODE *candidates[size];
+		CL *candidates[mset->size];
 		int choices = 0;
-		for(NODE *iter = *set; iter != NULL; iter = iter->next) {
-			if(cl_subsumer(xcsf, iter->cl) && cl_general(xcsf, iter->cl, c)) {
-				candidates[choices] = iter;
+		for(int i = 0; i < mset->size; i++) {
+			if(cl_subsumer(xcsf, mset->list[i]) && cl_general(xcsf, mset->list[i], c)) {
+				candidates[choices] = mset->list[i];
 				choices++;
 			}
 		}
 		// found
 		if(choices > 0) {
-			candidates[irand(0,choices)]->cl->num++;
-			xcsf->pop_num_sum++;
-			cl_free(xcsf, c);
+			CL *s = candidates[irand(0,choices)];
+			s->num++;
+			xcsf->pset.num++;
+			pop_update_cl(xcsf, s);
+			pool_put(xcsf, c);
 		}
 		// if no subsumers are found the offspring is added to the population
 		else {
-			pop_add(xcsf, c);   
+			ga_add(xcsf, c);   
 		}
 	}
 }
 
-CL *ga_select_parent(XCSF *xcsf, NODE **set, double fit_sum)
+void ga_add(XCSF *xcsf, CL *c)
+{
+	// an offspring identical to an existing classifier increases the
+	// numerosity of that classifier instead of being inserted
+	CL *dup = pop_find(xcsf, c);
+	if(dup != NULL) {
+		dup->num++;
+		xcsf->pset.num++;
+		pop_update_cl(xcsf, dup);
+		pool_put(xcsf, c);
+	}
+	else {
+		pop_add(xcsf, c);
+	}
+}
+
+CL *ga_select_parent(XCSF *xcsf, SET *mset, double fit_sum)
 {
 	(void)xcsf;
 	// selects a classifier using roullete wheel selection with the fitness
 	// (a fitness proportionate selection mechanism.)
 	double p = drand() * fit_sum;
-	NODE *iter = *set;
-	double sum = iter->cl->fit;
-	while(p > sum) {
-		iter = iter->next;
-		sum += iter->cl->fit;
+	int i = 0;
+	double sum = mset->list[i]->fit;
+	while(p > sum && i < mset->size-1) {
+		i++;
+		sum += mset->list[i]->fit;
 	}
-	return iter->cl;
+	return mset->list[i];
 }
@@ -34,6 +34,7 @@
 #include "random.h"
 #include "data_structures.h"
 #include "gp.h"
+#include "cl_index.h"
  
 #define GP_MAX_LEN 10000
 #define GP_NUM_FUNC 4
@@ -44,6 +45,7 @@
  
 int tree_grow(XCSF *xcsf, int *buffer, int p, int max, int depth);
 int tree_traverse(int *tree, int p);
+void tree_set(XCSF *xcsf, GP_TREE *gp, int *tree, int len);
 
 void tree_init_cons(XCSF *xcsf)
 {
@@ -63,6 +65,7 @@ void tree_init(XCSF *xcsf, GP_TREE *gp)
 {
 	(void)xcsf;
 	gp->tree = malloc(sizeof(int)*1);
+	gp->capacity = 1;
 }
 
 void tree_rand(XCSF *xcsf, GP_TREE *gp)
@@ -75,8 +78,92 @@ void tree_rand(XCSF *xcsf, GP_TREE *gp)
 	} while(len < 0);
 
 	// copy tree to this individual
-	gp->tree = malloc(sizeof(int)*len);
-	memcpy(gp->tree, buffer, sizeof(int)*len);
+	tree_set(xcsf, gp, buffer, len);
+}
+
+void tree_cover(XCSF *xcsf, GP_TREE *gp, double *x, double min)
+{
+	// adds a terminal to, or subtracts one from, the tree so that it evaluates
+	// above min for x; if no terminal allows this the tree is replaced by a
+	// terminal above min, or else by a sum of a terminal divided by itself,
+	// each evaluating to 1; it is only left unchanged if no terminal is both
+	// finite and nonzero
+	gp->p = 0;
+	double v = tree_eval(xcsf, gp, x);
+	int terms = xcsf->GP_NUM_CONS + xcsf->num_x_vars;
+	int func = -1;
+	int term = -1;
+	int n = 0;
+	// choose uniformly among the candidates
+	for(int i = 0; i < terms; i++) {
+		double t = i < xcsf->GP_NUM_CONS ? xcsf->gp_cons[i] : x[i - xcsf->GP_NUM_CONS];
+		if(v + t > min && irand(0, ++n) == 0) {
+			func = ADD;
+			term = i;
+		}
+		if(v - t > min && irand(0, ++n) == 0) {
+			func = SUB;
+			term = i;
+		}
+	}
+	for(int i = 0; n == 0 && i < terms; i++) {
+		double t = i < xcsf->GP_NUM_CONS ? xcsf->gp_cons[i] : x[i - xcsf->GP_NUM_CONS];
+		if(t > min && irand(0, ++n) == 0) {
+			term = i;
+		}
+	}
+	if(n == 0) {
+		int m = 0;
+		for(int i = 0; i < terms; i++) {
+			double t = i < xcsf->GP_NUM_CONS ? xcsf->gp_cons[i] : x[i - xcsf->GP_NUM_CONS];
+			if(t != 0.0 && isfinite(t) && irand(0, ++m) == 0) {
+				func = DIV;
+				term = i;
+			}
+		}
+	}
+	if(term < 0) {
+		return;
+	}
+	int leaf = GP_NUM_FUNC + term;
+	if(func < 0) {
+		tree_set(xcsf, gp, &leaf, 1);
+	}
+	else if(func == DIV) {
+		int ones = min < 1.0 ? 1 : (int) floor(min) + 1;
+		int len = 4 * ones - 1;
+		int buffer[len];
+		for(int k = 0, p = 0; k < ones; k++) {
+			if(k < ones - 1) {
+				buffer[p++] = ADD;
+			}
+			buffer[p++] = DIV;
+			buffer[p++] = leaf;
+			buffer[p++] = leaf;
+		}
+		tree_set(xcsf, gp, buffer, len);
+	}
+	else {
+		int len = tree_traverse(gp->tree, 0);
+		int buffer[len+2];
+		buffer[0] = func;
+		memcpy(&buffer[1], gp->tree, sizeof(int)*len);
+		buffer[len+1] = leaf;
+		tree_set(xcsf, gp, buffer, len+2);
+	}
+}
+
+void tree_set(XCSF *xcsf, GP_TREE *gp, int *tree, int len)
+{
+	// copies a tree into an individual; its buffer only grows when too short
+	// so that recycled individuals do not reallocate
+	(void)xcsf;
+	if(gp->capacity < len) {
+		free(gp->tree);
+		gp->tree = malloc(sizeof(int)*len);
+		gp->capacity = len;
+	}
+	memcpy(gp->tree, tree, sizeof(int)*len);
 }
 
 void tree_free(XCSF *xcsf, GP_TREE *gp)
@@ -204,14 +291,32 @@ int tree_print(XCSF *xcsf, GP_TREE *gp, int p)
 
 void tree_copy(XCSF *xcsf, GP_TREE *to, GP_TREE *from)
 {
-	(void)xcsf;
-	free(to->tree);
 	int len = tree_traverse(from->tree, 0);
-	to->tree = malloc(sizeof(int)*len);
-	memcpy(to->tree, from->tree, sizeof(int)*len);
+	tree_set(xcsf, to, from->tree, len);
 	to->p = from->p;               
 }
 
+size_t tree_heap(XCSF *xcsf, GP_TREE *gp)
+{
+	(void)xcsf;
+	return sizeof(int) * gp->capacity;
+}
+
+uint64_t tree_hash(XCSF *xcsf, GP_TREE *gp)
+{
+	(void)xcsf;
+	int len = tree_traverse(gp->tree, 0);
+	return hash_bytes(gp->tree, sizeof(int)*len, HASH_SEED);
+}
+
+_Bool tree_equal(XCSF *xcsf, GP_TREE *a, GP_TREE *b)
+{
+	(void)xcsf;
+	int len = tree_traverse(a->tree, 0);
+	return len == tree_traverse(b->tree, 0) && 
+		memcmp(a->tree, b->tree, sizeof(int)*len) == 0;
+}
+
 void tree_crossover(XCSF *xcsf, GP_TREE *p1, GP_TREE *p2)
 {
 	// sub-tree crossover
@@ -223,21 +328,19 @@ void tree_crossover(XCSF *xcsf, GP_TREE *p1, GP_TREE *p2)
 	int end2 = tree_traverse(p2->tree, start2);
 
 	int nlen1 = start1+(end2-start2)+(len1-end1);
-	int *new1 = malloc(sizeof(int)*nlen1);
+	int new1[nlen1];
 	memcpy(&new1[0], &p1->tree[0], sizeof(int)*start1);
 	memcpy(&new1[start1], &p2->tree[start2], sizeof(int)*(end2-start2));
 	memcpy(&new1[start1+(end2-start2)], &p1->tree[end1], sizeof(int)*(len1-end1));
 
 	int nlen2 = start2+(end1-start1)+(len2-end2);
-	int *new2 = malloc(sizeof(int)*nlen2);
+	int new2[nlen2];
 	memcpy(&new2[0], &p2->tree[0], sizeof(int)*start2);
 	memcpy(&new2[start2], &p1->tree[start1], sizeof(int)*(end1-start1));
 	memcpy(&new2[start2+(end1-start1)], &p2->tree[end2], sizeof(int)*(len2-end2));
 
-	tree_free(xcsf, p1);
-	tree_free(xcsf, p2);
-	p1->tree = new1;
-	p2->tree = new2;
+	tree_set(xcsf, p1, new1, nlen1);
+	tree_set(xcsf, p2, new2, nlen2);
 }
 
 void tree_mutation(XCSF *xcsf, GP_TREE *offspring, double rate) 
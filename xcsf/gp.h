@@ -18,6 +18,7 @@
  
 typedef struct GP_TREE {
 	int *tree;
+	int capacity; // allocated length of the tree
 	int p;
 } GP_TREE;
  
@@ -26,8 +27,12 @@ void tree_init_cons(XCSF *xcsf);
 void tree_init(XCSF *xcsf, GP_TREE *gp);
 void tree_free(XCSF *xcsf, GP_TREE *gp);
 void tree_rand(XCSF *xcsf, GP_TREE *gp);
+void tree_cover(XCSF *xcsf, GP_TREE *gp, double *x, double min);
 void tree_copy(XCSF *xcsf, GP_TREE *to, GP_TREE *from);
 int tree_print(XCSF *xcsf, GP_TREE *gp, int p);
 double tree_eval(XCSF *xcsf, GP_TREE *gp, double *x);
 void tree_crossover(XCSF *xcsf, GP_TREE *p1, GP_TREE *p2);
+_Bool tree_equal(XCSF *xcsf, GP_TREE *a, GP_TREE *b);
+uint64_t tree_hash(XCSF *xcsf, GP_TREE *gp);
+size_t tree_heap(XCSF *xcsf, GP_TREE *gp);
 void tree_mutation(XCSF *xcsf, GP_TREE *offspring, double rate);
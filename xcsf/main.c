@@ -25,6 +25,9 @@
  * 2) Executes the experiments: iteratively retrieving a problem instance,
  * generating a match set, calculating a system prediction, providing
  * reinforcement and running the genetic algorithm.
+ *
+ * 3) Provides the condensation of a trained population for cheaper inference,
+ * which is called from the Python wrapper.
  */
 
 #include <stdio.h>
@@ -39,9 +42,14 @@
 #include "cl.h"
 #include "cl_set.h"
 #include "ga.h"
+#include "pool.h"
 #include "input.h"
 #include "perf.h"
+#include "condense.h"
+#include "cl_batch.h"
+#include "cl_mcache.h"
 
+void xcsf_condense(XCSF *xcsf, INPUT *data, double *err);
 void xcsf_fit1(XCSF *xcsf, INPUT *train_data, _Bool shuffle);
 void xcsf_fit2(XCSF *xcsf, INPUT *train_data, INPUT *test_data, _Bool shuffle);
 void xcsf_predict(XCSF *xcsf, double *input, double *output, int rows);
@@ -77,11 +85,21 @@ int main(int argc, char **argv)
 
 	// initialise population
 	pop_init(xcsf);
+	pop_init_rand(xcsf);
 	// run an experiment
 	xcsf_fit2(xcsf, train_data, test_data, true);
+	if(xcsf->THETA_ENV > 0) {
+		long rejects, passes;
+		pop_env_counts(xcsf, &rejects, &passes);
+		printf("envelope rejects=%ld passes=%ld\n", rejects, passes);
+	}
+	if(xcsf->cover_tries > 0) {
+		printf("covering covers=%ld tries=%ld built=%ld\n",
+				xcsf->covers, xcsf->cover_tries, xcsf->cover_built);
+	}
 
 	// clean up
-	set_kill(xcsf, &xcsf->pset);
+	pop_free(xcsf);
 	constants_free(xcsf);        
 	free(xcsf);
 	input_free(train_data);
@@ -104,6 +122,10 @@ void xcsf_fit1(XCSF *xcsf, INPUT *train_data, _Bool shuffle)
 	double *pred = malloc(sizeof(double)*xcsf->num_y_vars);
 	// current sample
 	int row = 0;
+	// remember the classifiers matching each training sample
+	mcache_init(xcsf, train_data->x, train_data->rows);
+	// reference samples deciding the generality of match signatures
+	cl_sig_sample(xcsf, train_data->x, train_data->rows);
 	// each trial in an experiment
 	for(int cnt = 0; cnt < xcsf->MAX_TRIALS; cnt++) {
 		// select next training sample
@@ -124,6 +146,7 @@ void xcsf_fit1(XCSF *xcsf, INPUT *train_data, _Bool shuffle)
 	}
 
 	// clean up
+	mcache_free(xcsf);
 	free(pred);
 
 #ifdef GNUPLOT
@@ -144,6 +167,10 @@ void xcsf_fit2(XCSF *xcsf, INPUT *train_data, INPUT *test_data, _Bool shuffle)
 	double *pred = malloc(sizeof(double)*xcsf->num_y_vars);
 	// current sample
 	int row = 0;
+	// remember the classifiers matching each training sample
+	mcache_init(xcsf, train_data->x, train_data->rows);
+	// reference samples deciding the generality of match signatures
+	cl_sig_sample(xcsf, train_data->x, train_data->rows);
 	// each trial in an experiment
 	for(int cnt = 0; cnt < xcsf->MAX_TRIALS; cnt++) {
  		// select next training sample
@@ -175,6 +202,7 @@ void xcsf_fit2(XCSF *xcsf, INPUT *train_data, INPUT *test_data, _Bool shuffle)
 	}
 
 	// clean up
+	mcache_free(xcsf);
 	free(pred);
 
 #ifdef GNUPLOT
@@ -185,20 +213,20 @@ void xcsf_fit2(XCSF *xcsf, INPUT *train_data, INPUT *test_data, _Bool shuffle)
 double xcsf_learn_trial(XCSF *xcsf, double *pred, double *x, double *y)
 {
 	// create match set
-	NODE *mset = NULL, *kset = NULL;
-	int msize = 0, mnum = 0;
-	set_match(xcsf, &mset, &msize, &mnum, x, &kset);
+	SET *mset = &xcsf->mset;
+	SET *kset = &xcsf->kset;
+	set_match(xcsf, mset, x, kset);
 	// calculate system prediction
-	set_pred(xcsf, &mset, msize, x, pred);
+	set_pred(xcsf, mset, x, pred);
 	// provide reinforcement to the set
-	set_update(xcsf, &mset, &msize, &mnum, x, y, &kset);
+	set_update(xcsf, mset, x, y, kset);
 	// run the genetic algorithm
-	ga(xcsf, &mset, msize, mnum, &kset);
+	ga(xcsf, mset, kset);
 	// increment learning time
 	xcsf->time += 1;
 	// clean up
-	set_kill(xcsf, &kset); // kills deleted classifiers
-	set_free(xcsf, &mset); // frees the match set list
+	pool_put_set(xcsf, kset); // recycles deleted classifiers
+	set_clear(xcsf, mset); // empties the match set
 	// return the system error
 	double error = 0.0;
 	for(int i = 0; i < xcsf->num_y_vars; i++) {
@@ -211,14 +239,14 @@ double xcsf_learn_trial(XCSF *xcsf, double *pred, double *x, double *y)
 double xcsf_test_trial(XCSF *xcsf, double *pred, double *x, double *y)
 {
 	// create match set
-	NODE *mset = NULL, *kset = NULL;
-	int msize = 0, mnum = 0;
-	set_match(xcsf, &mset, &msize, &mnum, x, &kset);
+	SET *mset = &xcsf->mset;
+	SET *kset = &xcsf->kset;
+	set_match(xcsf, mset, x, kset);
 	// calculate system prediction
-	set_pred(xcsf, &mset, msize, x, pred);
+	set_pred(xcsf, mset, x, pred);
 	// clean up
-	set_kill(xcsf, &kset); // kills deleted classifiers
-	set_free(xcsf, &mset); // frees the match set list  
+	pool_put_set(xcsf, kset); // recycles deleted classifiers
+	set_clear(xcsf, mset); // empties the match set
 	// return the system error
 	double error = 0.0;
 	for(int i = 0; i < xcsf->num_y_vars; i++) {
@@ -230,29 +258,72 @@ double xcsf_test_trial(XCSF *xcsf, double *pred, double *x, double *y)
 
 void xcsf_predict(XCSF *xcsf, double *input, double *output, int rows)
 {   
-	for(int row = 0; row < rows; row++) {
+	// inputs are matched in batches; an input matched by too few classifiers
+	// is processed on its own so that covering is performed, after which the
+	// following inputs are matched against the changed population
+	SET *mset = &xcsf->mset;
+	SET *kset = &xcsf->kset;
+	uint64_t *bits = NULL;
+	int row = 0;
+	while(row < rows) {
+		int start = row;
+		int n = batch_pred(xcsf) ? rows - start : 0;
+		if(n > BATCH_ROWS) {
+			n = BATCH_ROWS;
+		}
+		int words = batch_words(xcsf);
+		if(n > 0 && words > 0) {
+			bits = realloc(bits, sizeof(uint64_t) * words * n);
+			batch_match(xcsf, &input[start*xcsf->num_x_vars], n, bits);
+			for(; row < start + n; row++) {
+				batch_set(xcsf, &bits[(row - start) * words], mset);
+				if(mset->size < xcsf->THETA_MNA) {
+					set_clear(xcsf, mset);
+					break;
+				}
+				set_pred(xcsf, mset, &input[row*xcsf->num_x_vars], &output[row*xcsf->num_y_vars]);
+				set_clear(xcsf, mset);
+			}
+			if(row == start + n) {
+				continue;
+			}
+		}
 		// create match set
-		NODE *mset = NULL, *kset = NULL;
-		int msize = 0, mnum = 0;
-		set_match(xcsf, &mset, &msize, &mnum, &input[row*xcsf->num_x_vars], &kset);
+		set_match(xcsf, mset, &input[row*xcsf->num_x_vars], kset);
 		// calculate system prediction
-		set_pred(xcsf, &mset, msize, &input[row*xcsf->num_x_vars], &output[row*xcsf->num_y_vars]);
+		set_pred(xcsf, mset, &input[row*xcsf->num_x_vars], &output[row*xcsf->num_y_vars]);
 		// clean up
-		set_kill(xcsf, &kset); // kills deleted classifiers
-		set_free(xcsf, &mset); // frees the match set list      
+		pool_put_set(xcsf, kset); // recycles deleted classifiers
+		set_clear(xcsf, mset); // empties the match set
+		row++;
 	}
+	free(bits);
+}
+
+void xcsf_condense(XCSF *xcsf, INPUT *data, double *err)
+{
+	// compacts the population; err receives the mean squared error over the
+	// data before and after condensation
+	int size = xcsf->pset.size;
+	err[0] = condense_error(xcsf, data);
+	int inaccurate = condense(xcsf, data);
+	err[1] = condense_error(xcsf, data);
+	disp_condense(xcsf, size, inaccurate, err[0], err[1]);
 }
 
 void xcsf_print_pop(XCSF *xcsf, _Bool print_cond, _Bool print_pred)
 {
-    set_print(xcsf, xcsf->pset, print_cond, print_pred);
+    set_print(xcsf, &xcsf->pset, print_cond, print_pred);
 }
 
 void xcsf_print_match_set(XCSF *xcsf, double *input, _Bool print_cond, _Bool print_pred)
 {
 	// create match set
-	NODE *mset = NULL, *kset = NULL;
-	int msize = 0, mnum = 0;
-	set_match(xcsf, &mset, &msize, &mnum, input, &kset);
-    set_print(xcsf, mset, print_cond, print_pred);
+	SET *mset = &xcsf->mset;
+	SET *kset = &xcsf->kset;
+	set_match(xcsf, mset, input, kset);
+	set_print(xcsf, mset, print_cond, print_pred);
+	// clean up
+	pool_put_set(xcsf, kset);
+	set_clear(xcsf, mset);
 }
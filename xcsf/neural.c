@@ -32,12 +32,14 @@
 #include "data_structures.h"
 #include "random.h"
 #include "neural.h"
+#include "cl_index.h"
 
 #define MAX_LAYERS 10
 #define MAX_NEURONS 50
 
 double neuron_propagate(XCSF *xcsf, NEURON *n, double *input);
 void neuron_init(XCSF *xcsf, NEURON *n, int num_inputs, double (*aptr)(double));
+void neuron_reinit(XCSF *xcsf, NEURON *n);
 void neuron_learn(XCSF *xcsf, NEURON *n, double error);
 
 void neural_init(XCSF *xcsf, BPN *bpn, int layers, int *neurons, double (**aptr)(double))
@@ -61,6 +63,16 @@ void neural_init(XCSF *xcsf, BPN *bpn, int layers, int *neurons, double (**aptr)
     }   
 }
 
+void neural_reinit(XCSF *xcsf, BPN *bpn)
+{
+    // restores the initial state of an allocated network
+    for(int l = 1; l < bpn->num_layers; l++) {
+        for(int i = 0; i < bpn->num_neurons[l]; i++) {
+            neuron_reinit(xcsf, &bpn->layer[l-1][i]);
+        }
+    }
+}
+
 void neural_rand(XCSF *xcsf, BPN *bpn)
 {
     for(int l = 1; l < bpn->num_layers; l++) {
@@ -74,6 +86,62 @@ void neural_rand(XCSF *xcsf, BPN *bpn)
     (void)xcsf;
 }
 
+void neural_bias(XCSF *xcsf, BPN *bpn, int i, double state)
+{
+    // shifts the bias of output neuron i so that its state for the last
+    // propagated input becomes state
+    NEURON *n = &bpn->layer[bpn->num_layers-2][i];
+    n->weights[n->num_inputs] += state - n->state;
+    (void)xcsf;
+}
+
+size_t neural_heap(XCSF *xcsf, BPN *bpn)
+{
+    // returns the number of bytes allocated by the network
+    (void)xcsf;
+    size_t bytes = sizeof(int) * bpn->num_layers + 
+        sizeof(NEURON*) * (bpn->num_layers - 1);
+    for(int l = 1; l < bpn->num_layers; l++) {
+        // each neuron has weights, weight changes, and inputs
+        bytes += bpn->num_neurons[l] * (sizeof(NEURON) + 
+                sizeof(double) * (3 * bpn->num_neurons[l-1] + 2));
+    }
+    return bytes;
+}
+
+uint64_t neural_hash(XCSF *xcsf, BPN *bpn)
+{
+    uint64_t h = HASH_SEED;
+    for(int l = 1; l < bpn->num_layers; l++) {
+        for(int i = 0; i < bpn->num_neurons[l]; i++) {
+            NEURON *n = &bpn->layer[l-1][i];
+            h = hash_bytes(n->weights, sizeof(double)*(n->num_inputs+1), h);
+        }
+    }
+    (void)xcsf;
+    return h;
+}
+
+_Bool neural_equal(XCSF *xcsf, BPN *a, BPN *b)
+{
+    // networks are identical if they have the same shape and weights
+    (void)xcsf;
+    if(a->num_layers != b->num_layers ||
+            memcmp(a->num_neurons, b->num_neurons, sizeof(int)*a->num_layers) != 0) {
+        return false;
+    }
+    for(int l = 1; l < a->num_layers; l++) {
+        for(int i = 0; i < a->num_neurons[l]; i++) {
+            NEURON *na = &a->layer[l-1][i];
+            NEURON *nb = &b->layer[l-1][i];
+            if(memcmp(na->weights, nb->weights, sizeof(double)*(na->num_inputs+1)) != 0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 void neural_propagate(XCSF *xcsf, BPN *bpn, double *input)
 {
     double tmpOut[MAX_LAYERS][MAX_NEURONS];
@@ -169,8 +237,8 @@ void neural_copy(XCSF *xcsf, BPN *to, BPN *from)
             a->activation_ptr = b->activation_ptr;
             a->output = b->output;
             a->state = b->state;
-            memcpy(a->weights, b->weights, sizeof(double)*b->num_inputs+1);
-            memcpy(a->weights_change, b->weights_change, sizeof(double)*b->num_inputs+1);
+            memcpy(a->weights, b->weights, sizeof(double)*(b->num_inputs+1));
+            memcpy(a->weights_change, b->weights_change, sizeof(double)*(b->num_inputs+1));
             memcpy(a->input, b->input, sizeof(double)*b->num_inputs);
             a->num_inputs = b->num_inputs;
         }
@@ -181,14 +249,19 @@ void neural_copy(XCSF *xcsf, BPN *to, BPN *from)
 void neuron_init(XCSF *xcsf, NEURON *n, int num_inputs, double (*aptr)(double))
 {
     n->activation_ptr = aptr;
-    n->output = 0.0;
-    n->state = 0.0;
     n->num_inputs = num_inputs; 
     n->weights = malloc((num_inputs+1)*sizeof(double));
     n->weights_change = malloc((num_inputs+1)*sizeof(double));
     n->input = malloc(num_inputs*sizeof(double));
+    neuron_reinit(xcsf, n);
+}
+
+void neuron_reinit(XCSF *xcsf, NEURON *n)
+{
+    n->output = 0.0;
+    n->state = 0.0;
     // randomise weights [-0.1,0.1]
-    for(int w = 0; w < num_inputs+1; w++) {
+    for(int w = 0; w < n->num_inputs+1; w++) {
         n->weights[w] = 0.2 * (drand() - 0.5);
         n->weights_change[w] = 0.0;
     }
@@ -31,13 +31,18 @@ typedef struct BPN {
     NEURON **layer; // neural network
 } BPN;
 
+_Bool neural_equal(XCSF *xcsf, BPN *a, BPN *b);
 double neural_output(XCSF *xcsf, BPN *bpn, int i);
+uint64_t neural_hash(XCSF *xcsf, BPN *bpn);
+size_t neural_heap(XCSF *xcsf, BPN *bpn);
 void neural_copy(XCSF *xcsf, BPN *to, BPN *from);
 void neural_free(XCSF *xcsf, BPN *bpn);
 void neural_learn(XCSF *xcsf, BPN *bpn, double *output, double *state);
 void neural_print(XCSF *xcsf, BPN *bpn);
 void neural_propagate(XCSF *xcsf, BPN *bpn, double *input);
 void neural_rand(XCSF *xcsf, BPN *bpn);
+void neural_bias(XCSF *xcsf, BPN *bpn, int i, double state);
+void neural_reinit(XCSF *xcsf, BPN *bpn);
 void neural_init(XCSF *xcsf, BPN *bpn, int layers, int *neurons, double (**aptr)(double));
 
 // activation functions
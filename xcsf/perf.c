@@ -41,6 +41,14 @@ char fname[50]; // file name for performance data
 void gplot_draw(XCSF *xcsf, _Bool test_error);
 #endif
  
+void disp_condense(XCSF *xcsf, int size, int inaccurate, double err, double cerr)
+{
+	printf("condensed %d -> %d macro-classifiers, error %.5f -> %.5f, "
+			"%d inputs without an accurate classifier\n",
+			size, xcsf->pset.size, err, cerr, inaccurate);
+	fflush(stdout);
+}
+
 void disp_perf1(XCSF *xcsf, double *error, int trial)
 {
 	double serr = 0.0;
@@ -48,17 +56,17 @@ void disp_perf1(XCSF *xcsf, double *error, int trial)
 		serr += error[i];
 	}
 	serr /= (double)xcsf->PERF_AVG_TRIALS;
-	printf("%d %.5f %d", trial, serr, xcsf->pop_num);
+	printf("%d %.5f %d", trial, serr, xcsf->pset.size);
 	for(int i = 0; i < xcsf->NUM_SAM; i++) {
-		printf(" %.5f", set_avg_mut(xcsf, &xcsf->pset, i));
+		printf(" %.5f", pop_avg_mu(xcsf, i));
 	}
 	printf("\n");    
 	fflush(stdout);
 
 #ifdef GNUPLOT
-	fprintf(fout, "%d %.5f %d", trial, serr, xcsf->pop_num);
+	fprintf(fout, "%d %.5f %d", trial, serr, xcsf->pset.size);
 	for(int i = 0; i < xcsf->NUM_SAM; i++) {
-		fprintf(fout, " %.5f", set_avg_mut(xcsf, &xcsf->pset, i));
+		fprintf(fout, " %.5f", pop_avg_mu(xcsf, i));
 	}
 	fprintf(fout, "\n");
 	fflush(fout);
@@ -77,17 +85,17 @@ void disp_perf2(XCSF *xcsf, double *error, double *terror, int trial)
 	}
 	serr /= (double)xcsf->PERF_AVG_TRIALS;
 	terr /= (double)xcsf->PERF_AVG_TRIALS;
-	printf("%d %.5f %.5f %d", trial, serr, terr, xcsf->pop_num);
+	printf("%d %.5f %.5f %d", trial, serr, terr, xcsf->pset.size);
 	for(int i = 0; i < xcsf->NUM_SAM; i++) {
-		printf(" %.5f", set_avg_mut(xcsf, &xcsf->pset, i));
+		printf(" %.5f", pop_avg_mu(xcsf, i));
 	}
 	printf("\n");    
 	fflush(stdout);
 
 #ifdef GNUPLOT
-	fprintf(fout, "%d %.5f %.5f %d", trial, serr, terr, xcsf->pop_num);
+	fprintf(fout, "%d %.5f %.5f %d", trial, serr, terr, xcsf->pset.size);
 	for(int i = 0; i < xcsf->NUM_SAM; i++) {
-		fprintf(fout, " %.5f", set_avg_mut(xcsf, &xcsf->pset, i));
+		fprintf(fout, " %.5f", pop_avg_mu(xcsf, i));
 	}
 	fprintf(fout, "\n");
 	fflush(fout);
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2019 Richard Preen <rpreen@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **************
+ * Description: 
+ **************
+ * The classifier pool module.
+ *
+ * Retains the classifiers deleted from the population, with their condition
+ * and prediction structures still allocated, so that the classifiers created
+ * by covering and the genetic algorithm can reuse them. Once the population
+ * has reached its maximum size, each new classifier therefore replaces a
+ * deleted one without any memory allocation. Pooled classifiers whose
+ * condition or prediction type no longer matches the current configuration
+ * are freed rather than reused.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "data_structures.h"
+#include "cl.h"
+#include "cl_set.h"
+#include "pool.h"
+
+void pool_init(XCSF *xcsf)
+{
+    set_init(xcsf, &xcsf->pool);
+}
+
+void pool_free(XCSF *xcsf)
+{
+    // frees the pool and the classifiers retained
+    set_kill(xcsf, &xcsf->pool);
+}
+
+CL *pool_get(XCSF *xcsf, int size, int time)
+{
+    // returns an initialised classifier, recycling a pooled one if possible
+    SET *pool = &xcsf->pool;
+    while(pool->size > 0) {
+        CL *c = pool->list[pool->size-1];
+        set_remove(xcsf, pool, pool->size-1);
+        if(cl_reinit(xcsf, c, size, time)) {
+            return c;
+        }
+        cl_free(xcsf, c);
+    }
+    CL *c = cl_alloc(xcsf);
+    cl_init(xcsf, c, size, time);
+    return c;
+}
+
+void pool_put(XCSF *xcsf, CL *c)
+{
+    // retains a classifier that is no longer in use
+    c->num = 0;
+    set_add(xcsf, &xcsf->pool, c);
+}
+
+void pool_put_set(XCSF *xcsf, SET *set)
+{
+    // retains all classifiers in a set and empties it
+    for(int i = 0; i < set->size; i++) {
+        pool_put(xcsf, set->list[i]);
+    }
+    set_clear(xcsf, set);
+}
@@ -84,6 +84,12 @@ void pred_neural_init(XCSF *xcsf, CL *c)
     c->pred = pred;
 }
 
+void pred_neural_reinit(XCSF *xcsf, CL *c)
+{
+    PRED_NEURAL *pred = c->pred;
+    neural_reinit(xcsf, &pred->bpn);
+}
+
 void pred_neural_free(XCSF *xcsf, CL *c)
 {
     PRED_NEURAL *pred = c->pred;
@@ -122,6 +128,20 @@ double pred_neural_pre(XCSF *xcsf, CL *c, int p)
     return pred->pre[p];
 }
 
+size_t pred_neural_bytes(XCSF *xcsf)
+{
+    // allocated separately from the classifier
+    (void)xcsf;
+    return 0;
+}
+
+size_t pred_neural_heap(XCSF *xcsf, CL *c)
+{
+    PRED_NEURAL *pred = c->pred;
+    return sizeof(PRED_NEURAL) + sizeof(double) * xcsf->num_y_vars +
+        neural_heap(xcsf, &pred->bpn);
+}
+
 void pred_neural_print(XCSF *xcsf, CL *c)
 {
     PRED_NEURAL *pred = c->pred;
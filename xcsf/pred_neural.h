@@ -16,19 +16,25 @@
  */
 
 double pred_neural_pre(XCSF *xcsf, CL *c, int p);
+size_t pred_neural_bytes(XCSF *xcsf);
+size_t pred_neural_heap(XCSF *xcsf, CL *c);
 double *pred_neural_compute(XCSF *xcsf, CL *c, double *x);
 void pred_neural_copy(XCSF *xcsf, CL *to,  CL *from);
 void pred_neural_free(XCSF *xcsf, CL *c);
 void pred_neural_init(XCSF *xcsf, CL *c);
 void pred_neural_print(XCSF *xcsf, CL *c);
+void pred_neural_reinit(XCSF *xcsf, CL *c);
 void pred_neural_update(XCSF *xcsf, CL *c, double *y, double *x);
 
 static struct PredVtbl const pred_neural_vtbl = {
 	&pred_neural_compute,
 	&pred_neural_pre,
+	&pred_neural_bytes,
+	&pred_neural_heap,
 	&pred_neural_copy,
 	&pred_neural_free,
 	&pred_neural_init,
 	&pred_neural_print,
+	&pred_neural_reinit,
 	&pred_neural_update
 };
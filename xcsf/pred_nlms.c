@@ -41,62 +41,14 @@ typedef struct PRED_NLMS {
 	double *pre;
 } PRED_NLMS;
 
-void pred_nlms_init(XCSF *xcsf, CL *c)
-{
-	PRED_NLMS *pred = malloc(sizeof(PRED_NLMS));
-	c->pred = pred;
-
-	if(xcsf->PRED_TYPE == 1) {
-		// offset(1) + n linear + n quadratic + n*(n-1)/2 mixed terms
-		pred->weights_length = 1 + 2 * xcsf->num_x_vars + 
-			xcsf->num_x_vars * (xcsf->num_x_vars - 1) / 2;
-	}
-	else {
-		pred->weights_length = xcsf->num_x_vars+1;
-	}
-
-	pred->weights = malloc(sizeof(double*) * xcsf->num_y_vars);
-	for(int var = 0; var < xcsf->num_y_vars; var++) {
-		pred->weights[var] = malloc(sizeof(double)*pred->weights_length);
-	}
-	for(int var = 0; var < xcsf->num_y_vars; var++) {
-		pred->weights[var][0] = xcsf->XCSF_X0;
-		for(int i = 1; i < pred->weights_length; i++) {
-			pred->weights[var][i] = 0.0;
-		}
-	}
-
-	pred->pre = malloc(sizeof(double) * xcsf->num_y_vars);
-}
-
-void pred_nlms_copy(XCSF *xcsf, CL *to, CL *from)
-{
-	PRED_NLMS *to_pred = to->pred;
-	PRED_NLMS *from_pred = from->pred;
-	for(int var = 0; var < xcsf->num_y_vars; var++) {
-		memcpy(to_pred->weights[var], from_pred->weights[var], 
-				sizeof(double)*from_pred->weights_length);
-	}
-	memcpy(to_pred->pre, from_pred->pre, sizeof(double) * xcsf->num_y_vars);
-}
-
-void pred_nlms_free(XCSF *xcsf, CL *c)
-{
-	PRED_NLMS *pred = c->pred;
-	for(int var = 0; var < xcsf->num_y_vars; var++) {
-		free(pred->weights[var]);
-	}
-	free(pred->weights);
-	free(pred->pre);
-	free(pred);
-}
+int pred_nlms_weights_length(XCSF *xcsf);
 
-void pred_nlms_update(XCSF *xcsf, CL *c, double *y, double *x)
+static inline void pred_nlms_update_dim(XCSF *xcsf, CL *c, double *y, double *x, int n)
 {
 	PRED_NLMS *pred = c->pred;
 
 	double norm = xcsf->XCSF_X0 * xcsf->XCSF_X0;
-	for(int i = 0; i < xcsf->num_x_vars; i++) {
+	for(int i = 0; i < n; i++) {
 		norm += x[i] * x[i];
 	}      
 
@@ -108,14 +60,14 @@ void pred_nlms_update(XCSF *xcsf, CL *c, double *y, double *x)
 		pred->weights[var][0] += xcsf->XCSF_X0 * correction;
 		int index = 1;
 		// update linear coefficients
-		for(int i = 0; i < xcsf->num_x_vars; i++) {
+		for(int i = 0; i < n; i++) {
 			pred->weights[var][index++] += correction * x[i];
 		}
 
 		if(xcsf->PRED_TYPE == 1) {
 			// update quadratic coefficients
-			for(int i = 0; i < xcsf->num_x_vars; i++) {
-				for(int j = i; j < xcsf->num_x_vars; j++) {
+			for(int i = 0; i < n; i++) {
+				for(int j = i; j < n; j++) {
 					pred->weights[var][index++] += correction * x[i] * x[j];
 				}
 			}
@@ -123,7 +75,7 @@ void pred_nlms_update(XCSF *xcsf, CL *c, double *y, double *x)
 	}
 }
 
-double *pred_nlms_compute(XCSF *xcsf, CL *c, double *x)
+static inline double *pred_nlms_compute_dim(XCSF *xcsf, CL *c, double *x, int n)
 {
 	PRED_NLMS *pred = c->pred;
 	for(int var = 0; var < xcsf->num_y_vars; var++) {
@@ -131,14 +83,14 @@ double *pred_nlms_compute(XCSF *xcsf, CL *c, double *x)
 		double pre = xcsf->XCSF_X0 * pred->weights[var][0];
 		int index = 1;
 		// multiply linear coefficients with the prediction input
-		for(int i = 0; i < xcsf->num_x_vars; i++) {
+		for(int i = 0; i < n; i++) {
 			pre += pred->weights[var][index++] * x[i];
 		}
 
 		if(xcsf->PRED_TYPE == 1) {
 			// multiply quadratic coefficients with prediction input
-			for(int i = 0; i < xcsf->num_x_vars; i++) {
-				for(int j = i; j < xcsf->num_x_vars; j++) {
+			for(int i = 0; i < n; i++) {
+				for(int j = i; j < n; j++) {
 					pre += pred->weights[var][index++] * x[i] * x[j];
 				}
 			}
@@ -147,6 +99,108 @@ double *pred_nlms_compute(XCSF *xcsf, CL *c, double *x)
 		pred->pre[var] = pre;
 	}
 	return pred->pre;
+}
+
+// the prediction and update for a number of input variables known at
+// compile time, so that the loops over the weights are unrolled
+#define PRED_NLMS_COMPUTE_DIM(n) \
+	double *pred_nlms_compute_##n(XCSF *xcsf, CL *c, double *x) \
+	{ \
+		return pred_nlms_compute_dim(xcsf, c, x, n); \
+	}
+#define PRED_NLMS_COMPUTE_CASE(n) case n: return pred_nlms_compute_##n(xcsf, c, x);
+#define PRED_NLMS_UPDATE_DIM(n) \
+	void pred_nlms_update_##n(XCSF *xcsf, CL *c, double *y, double *x) \
+	{ \
+		pred_nlms_update_dim(xcsf, c, y, x, n); \
+	}
+#define PRED_NLMS_UPDATE_CASE(n) case n: pred_nlms_update_##n(xcsf, c, y, x); return;
+
+CL_FIXED_DIMS(PRED_NLMS_COMPUTE_DIM)
+CL_FIXED_DIMS(PRED_NLMS_UPDATE_DIM)
+
+void pred_nlms_init(XCSF *xcsf, CL *c)
+{
+	// the prediction is stored within the classifier's memory block:
+	// [PRED_NLMS][weight row pointers][weights][pre]
+	PRED_NLMS *pred = c->pred;
+	pred->weights_length = pred_nlms_weights_length(xcsf);
+	pred->weights = (double **) (pred + 1);
+	double *w = (double *) (pred->weights + xcsf->num_y_vars);
+	for(int var = 0; var < xcsf->num_y_vars; var++) {
+		pred->weights[var] = w + var * pred->weights_length;
+	}
+	pred->pre = w + xcsf->num_y_vars * pred->weights_length;
+	pred_nlms_reinit(xcsf, c);
+}
+
+int pred_nlms_weights_length(XCSF *xcsf)
+{
+	if(xcsf->PRED_TYPE == 1) {
+		// offset(1) + n linear + n quadratic + n*(n-1)/2 mixed terms
+		return 1 + 2 * xcsf->num_x_vars + 
+			xcsf->num_x_vars * (xcsf->num_x_vars - 1) / 2;
+	}
+	return xcsf->num_x_vars+1;
+}
+
+size_t pred_nlms_bytes(XCSF *xcsf)
+{
+	return sizeof(PRED_NLMS) + sizeof(double*) * xcsf->num_y_vars +
+		sizeof(double) * xcsf->num_y_vars * (pred_nlms_weights_length(xcsf) + 1);
+}
+
+size_t pred_nlms_heap(XCSF *xcsf, CL *c)
+{
+	// stored within the classifier's memory block
+	(void)xcsf;
+	(void)c;
+	return 0;
+}
+
+void pred_nlms_reinit(XCSF *xcsf, CL *c)
+{
+	PRED_NLMS *pred = c->pred;
+	for(int var = 0; var < xcsf->num_y_vars; var++) {
+		pred->weights[var][0] = xcsf->XCSF_X0;
+		for(int i = 1; i < pred->weights_length; i++) {
+			pred->weights[var][i] = 0.0;
+		}
+	}
+}
+
+void pred_nlms_copy(XCSF *xcsf, CL *to, CL *from)
+{
+	PRED_NLMS *to_pred = to->pred;
+	PRED_NLMS *from_pred = from->pred;
+	// weights and pre are contiguous
+	memcpy(to_pred->weights[0], from_pred->weights[0], 
+			sizeof(double) * xcsf->num_y_vars * (from_pred->weights_length + 1));
+}
+
+void pred_nlms_free(XCSF *xcsf, CL *c)
+{
+	// freed along with the classifier
+	(void)xcsf;
+	(void)c;
+}
+
+void pred_nlms_update(XCSF *xcsf, CL *c, double *y, double *x)
+{
+	switch(xcsf->num_x_vars) {
+		CL_FIXED_DIMS(PRED_NLMS_UPDATE_CASE)
+		default: break;
+	}
+	pred_nlms_update_dim(xcsf, c, y, x, xcsf->num_x_vars);
+}
+
+double *pred_nlms_compute(XCSF *xcsf, CL *c, double *x)
+{
+	switch(xcsf->num_x_vars) {
+		CL_FIXED_DIMS(PRED_NLMS_COMPUTE_CASE)
+		default: break;
+	}
+	return pred_nlms_compute_dim(xcsf, c, x, xcsf->num_x_vars);
 } 
 
 double pred_nlms_pre(XCSF *xcsf, CL *c, int p)
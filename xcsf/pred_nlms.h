@@ -16,19 +16,25 @@
  */
 
 double pred_nlms_pre(XCSF *xcsf, CL *c, int p);
+size_t pred_nlms_bytes(XCSF *xcsf);
+size_t pred_nlms_heap(XCSF *xcsf, CL *c);
 double *pred_nlms_compute(XCSF *xcsf, CL *c, double *x);
 void pred_nlms_copy(XCSF *xcsf, CL *to,  CL *from);
 void pred_nlms_free(XCSF *xcsf, CL *c);
 void pred_nlms_init(XCSF *xcsf, CL *c);
 void pred_nlms_print(XCSF *xcsf, CL *c);
+void pred_nlms_reinit(XCSF *xcsf, CL *c);
 void pred_nlms_update(XCSF *xcsf, CL *c, double *y, double *x);
 
 static struct PredVtbl const pred_nlms_vtbl = {
 	&pred_nlms_compute,
 	&pred_nlms_pre,
+	&pred_nlms_bytes,
+	&pred_nlms_heap,
 	&pred_nlms_copy,
 	&pred_nlms_free,
 	&pred_nlms_init,
 	&pred_nlms_print,
+	&pred_nlms_reinit,
 	&pred_nlms_update
 };
@@ -33,6 +33,7 @@
 void matrix_matrix_multiply(double *srca, double *srcb, double *dest, int n);
 void matrix_vector_multiply(double *srcm, double *srcv, double *dest, int n);
 void init_matrix(XCSF *xcsf, double *matrix, int n);
+int pred_rls_weights_length(XCSF *xcsf);
 
 typedef struct PRED_RLS {
 	int weights_length;
@@ -43,35 +44,56 @@ typedef struct PRED_RLS {
 
 void pred_rls_init(XCSF *xcsf, CL *c)
 {
-	PRED_RLS *pred = malloc(sizeof(PRED_RLS));
-	c->pred = pred;
+	// the prediction is stored within the classifier's memory block:
+	// [PRED_RLS][weight row pointers][weights][pre][gain matrix]
+	PRED_RLS *pred = c->pred;
+	pred->weights_length = pred_rls_weights_length(xcsf);
+	pred->weights = (double **) (pred + 1);
+	double *w = (double *) (pred->weights + xcsf->num_y_vars);
+	for(int var = 0; var < xcsf->num_y_vars; var++) {
+		pred->weights[var] = w + var * pred->weights_length;
+	}
+	pred->pre = w + xcsf->num_y_vars * pred->weights_length;
+	pred->matrix = pred->pre + xcsf->num_y_vars;
+	pred_rls_reinit(xcsf, c);
+}
 
+int pred_rls_weights_length(XCSF *xcsf)
+{
 	if(xcsf->PRED_TYPE == 3) {
 		// offset(1) + n linear + n quadratic + n*(n-1)/2 mixed terms
-		pred->weights_length = 1 + 2 * xcsf->num_x_vars + 
+		return 1 + 2 * xcsf->num_x_vars + 
 			xcsf->num_x_vars * (xcsf->num_x_vars - 1) / 2;
 	}
-	else {
-		pred->weights_length = xcsf->num_x_vars + 1;
-	}
+	return xcsf->num_x_vars + 1;
+}
 
-	pred->weights = malloc(sizeof(double*) * xcsf->num_y_vars);
-	for(int var = 0; var < xcsf->num_y_vars; var++) {
-		pred->weights[var] = malloc(sizeof(double)*pred->weights_length);
-	}
+size_t pred_rls_bytes(XCSF *xcsf)
+{
+	int n = pred_rls_weights_length(xcsf);
+	return sizeof(PRED_RLS) + sizeof(double*) * xcsf->num_y_vars +
+		sizeof(double) * (xcsf->num_y_vars * (n + 1) + n * n);
+}
+
+size_t pred_rls_heap(XCSF *xcsf, CL *c)
+{
+	// stored within the classifier's memory block
+	(void)xcsf;
+	(void)c;
+	return 0;
+}
+
+void pred_rls_reinit(XCSF *xcsf, CL *c)
+{
+	PRED_RLS *pred = c->pred;
 	for(int var = 0; var < xcsf->num_y_vars; var++) {
 		pred->weights[var][0] = xcsf->XCSF_X0;
 		for(int i = 1; i < pred->weights_length; i++) {
 			pred->weights[var][i] = 0.0;
 		}
 	}
-
 	// initialise gain matrix
-	pred->matrix = malloc(sizeof(double)*pred->weights_length*pred->weights_length);
 	init_matrix(xcsf, pred->matrix, pred->weights_length);
-
-	// initialise current prediction
-	pred->pre = malloc(sizeof(double) * xcsf->num_y_vars);
 }
 
 void init_matrix(XCSF *xcsf, double *matrix, int n)
@@ -92,23 +114,16 @@ void pred_rls_copy(XCSF *xcsf, CL *to, CL *from)
 {
 	PRED_RLS *to_pred = to->pred;
 	PRED_RLS *from_pred = from->pred;
-	for(int var = 0; var < xcsf->num_y_vars; var++) {
-		memcpy(to_pred->weights[var], from_pred->weights[var], 
-				sizeof(double)*from_pred->weights_length);
-	}
-	memcpy(to_pred->pre, from_pred->pre, sizeof(double) * xcsf->num_y_vars);
+	// weights and pre are contiguous
+	memcpy(to_pred->weights[0], from_pred->weights[0], 
+			sizeof(double) * xcsf->num_y_vars * (from_pred->weights_length + 1));
 }
 
 void pred_rls_free(XCSF *xcsf, CL *c)
 {
-	PRED_RLS *pred = c->pred;
-	for(int var = 0; var < xcsf->num_y_vars; var++) {
-		free(pred->weights[var]);
-	}
-	free(pred->weights);
-	free(pred->matrix);
-	free(pred->pre);
-	free(pred);
+	// freed along with the classifier
+	(void)xcsf;
+	(void)c;
 }
 
 void pred_rls_update(XCSF *xcsf, CL *c, double *y, double *x)
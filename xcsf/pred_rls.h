@@ -16,19 +16,25 @@
  */
 
 double pred_rls_pre(XCSF *xcsf, CL *c, int p);
+size_t pred_rls_bytes(XCSF *xcsf);
+size_t pred_rls_heap(XCSF *xcsf, CL *c);
 double *pred_rls_compute(XCSF *xcsf, CL *c, double *x);
 void pred_rls_copy(XCSF *xcsf, CL *to,  CL *from);
 void pred_rls_free(XCSF *xcsf, CL *c);
 void pred_rls_init(XCSF *xcsf, CL *c);
 void pred_rls_print(XCSF *xcsf, CL *c);
+void pred_rls_reinit(XCSF *xcsf, CL *c);
 void pred_rls_update(XCSF *xcsf, CL *c, double *y, double *x);
 
 static struct PredVtbl const pred_rls_vtbl = {
 	&pred_rls_compute,
 	&pred_rls_pre,
+	&pred_rls_bytes,
+	&pred_rls_heap,
 	&pred_rls_copy,
 	&pred_rls_free,
 	&pred_rls_init,
 	&pred_rls_print,
+	&pred_rls_reinit,
 	&pred_rls_update
 };
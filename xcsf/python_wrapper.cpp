@@ -32,6 +32,7 @@ extern "C" {
 #include "cl_set.h"
 }
 
+extern "C" void xcsf_condense(XCSF *, INPUT *, double *);
 extern "C" void xcsf_fit1(XCSF *, INPUT *, _Bool);
 extern "C" void xcsf_fit2(XCSF *, INPUT *, INPUT *, _Bool);
 extern "C" void xcsf_predict(XCSF *, double *, double *, int);
@@ -52,9 +53,7 @@ struct XCS
 		constants_init(&xcs, filename);
 		xcs.num_x_vars = num_x_vars;
 		xcs.num_y_vars = num_y_vars;
-		xcs.pop_num = 0;
-		xcs.pop_num_sum = 0;
-		xcs.time = 0;
+		pop_init(&xcs);
 		train_data.rows = 0;
 		train_data.x_cols = 0;
 		train_data.y_cols = 0;
@@ -80,8 +79,8 @@ struct XCS
 		train_data.x = reinterpret_cast<double*>(train_X.get_data());
 		train_data.y = reinterpret_cast<double*>(train_Y.get_data());
 		// first execution
-		if(xcs.pop_num == 0) {
-			pop_init(&xcs);
+		if(xcs.pset.size == 0) {
+			pop_init_rand(&xcs);
 		}       
 		// execute
 		xcsf_fit1(&xcs, &train_data, shuffle);
@@ -119,13 +118,40 @@ struct XCS
 		test_data.x = reinterpret_cast<double*>(test_X.get_data());
 		test_data.y = reinterpret_cast<double*>(test_Y.get_data());
 		// first execution
-		if(xcs.pop_num == 0) {
-			pop_init(&xcs);
+		if(xcs.pset.size == 0) {
+			pop_init_rand(&xcs);
 		}       
 		// execute
 		xcsf_fit2(&xcs, &train_data, &test_data, shuffle);
 	}
 
+	p::tuple condense(np::ndarray &X, np::ndarray &Y) {
+		// check inputs are correctly sized
+		if(X.shape(0) != Y.shape(0)) {
+			printf("error: X and Y rows are not equal\n");
+			return p::make_tuple();
+		}
+		if(X.shape(1) != xcs.num_x_vars) {
+			printf("error: number of X cols is not equal to num_x_vars\n");
+			return p::make_tuple();
+		}
+		if(Y.shape(1) != xcs.num_y_vars) {
+			printf("error: number of Y cols is not equal to num_y_vars\n");
+			return p::make_tuple();
+		}
+		INPUT data;
+		data.rows = X.shape(0);
+		data.x_cols = X.shape(1);
+		data.y_cols = Y.shape(1);
+		data.x = reinterpret_cast<double*>(X.get_data());
+		data.y = reinterpret_cast<double*>(Y.get_data());
+		// execute; returns the population size and error before and after
+		int size = xcs.pset.size;
+		double err[2];
+		xcsf_condense(&xcs, &data, err);
+		return p::make_tuple(size, xcs.pset.size, err[0], err[1]);
+	}
+
 	np::ndarray predict(np::ndarray &T) {
 		// inputs to predict
 		double *input = reinterpret_cast<double*>(T.get_data());
@@ -155,6 +181,8 @@ struct XCS
 	int get_max_trials() { return xcs.MAX_TRIALS; }
 	int get_perf_avg_trials() { return xcs.PERF_AVG_TRIALS; }
 	int get_pop_size() { return xcs.POP_SIZE; }
+	size_t get_max_pop_bytes() { return xcs.MAX_POP_BYTES; }
+	size_t get_match_cache_bytes() { return xcs.MATCH_CACHE_BYTES; }
 	double get_alpha() { return xcs.ALPHA; }
 	double get_beta() { return xcs.BETA; }
 	double get_delta() { return xcs.DELTA; }
@@ -175,6 +203,8 @@ struct XCS
 	int get_num_sam() { return xcs.NUM_SAM; }
 	double get_max_con() { return xcs.MAX_CON; }
 	double get_min_con() { return xcs.MIN_CON; }
+	double get_p_dontcare() { return xcs.P_DONTCARE; }
+	int get_theta_env() { return xcs.THETA_ENV; }
 	double get_s_mutation() { return xcs.S_MUTATION; }
 	int get_num_hidden_neurons() { return xcs.NUM_HIDDEN_NEURONS; }
 	int get_hidden_neuron_activation() { return xcs.HIDDEN_NEURON_ACTIVATION; }
@@ -186,10 +216,33 @@ struct XCS
 	double get_rls_scale_factor() { return xcs.RLS_SCALE_FACTOR; }
 	double get_rls_lambda() { return xcs.RLS_LAMBDA; }
 	double get_theta_sub() { return xcs.THETA_SUB; }
+	int get_sig_samples() { return xcs.SIG_SAMPLES; }
 	_Bool get_ga_subsumption() { return xcs.GA_SUBSUMPTION; }
 	_Bool get_set_subsumption() { return xcs.SET_SUBSUMPTION; }
-	int get_pop_num() { return xcs.pop_num; }
-	int get_pop_num_sum() { return xcs.pop_num_sum; }
+	int get_pop_num() { return xcs.pset.size; }
+	int get_pop_num_sum() { return xcs.pset.num; }
+	size_t get_pop_bytes() { return xcs.pop_bytes; }
+	double get_pop_total_fit() { return pop_total_fit(&xcs); }
+	long get_env_rejects() {
+		long rejects, passes;
+		pop_env_counts(&xcs, &rejects, &passes);
+		return rejects;
+	}
+	long get_env_passes() {
+		long rejects, passes;
+		pop_env_counts(&xcs, &rejects, &passes);
+		return passes;
+	}
+	long get_covers() { return xcs.covers; }
+	long get_cover_tries() { return xcs.cover_tries; }
+	long get_cover_built() { return xcs.cover_built; }
+	double get_pop_avg_mu(int m) {
+		if(m < 0 || m >= xcs.mu_len) {
+			printf("error: invalid mutation rate index: %d\n", m);
+			return 0.0;
+		}
+		return pop_avg_mu(&xcs, m);
+	}
 	int get_time() { return xcs.time; }
 	double get_num_x_vars() { return xcs.num_x_vars; }
 	double get_num_y_vars() { return xcs.num_y_vars; }                      
@@ -200,6 +253,8 @@ struct XCS
 	void set_max_trials(int a) { xcs.MAX_TRIALS = a; }
 	void set_perf_avg_trials(int a) { xcs.PERF_AVG_TRIALS = a; }
 	void set_pop_size(int a) { xcs.POP_SIZE = a; }
+	void set_max_pop_bytes(size_t a) { xcs.MAX_POP_BYTES = a; }
+	void set_match_cache_bytes(size_t a) { xcs.MATCH_CACHE_BYTES = a; }
 	void set_alpha(double a) { xcs.ALPHA = a; }
 	void set_beta(double a) { xcs.BETA = a; }
 	void set_delta(double a) { xcs.DELTA = a; }
@@ -220,6 +275,8 @@ struct XCS
 	void set_num_sam(int a) { xcs.NUM_SAM = a; }
 	void set_max_con(double a) { xcs.MAX_CON = a; }
 	void set_min_con(double a) { xcs.MIN_CON = a; }
+	void set_p_dontcare(double a) { xcs.P_DONTCARE = a; }
+	void set_theta_env(int a) { xcs.THETA_ENV = a; }
 	void set_s_mutation(double a) { xcs.S_MUTATION = a; }
 	void set_num_hidden_neurons(int a) { xcs.NUM_HIDDEN_NEURONS = a; }
 	void set_hidden_neuron_activation(int a) { xcs.HIDDEN_NEURON_ACTIVATION = a; }
@@ -231,6 +288,7 @@ struct XCS
 	void set_rls_scale_factor(double a) { xcs.RLS_SCALE_FACTOR = a; }
 	void set_rls_lambda(double a) { xcs.RLS_LAMBDA = a; }
 	void set_theta_sub(double a) { xcs.THETA_SUB = a; }
+	void set_sig_samples(int a) { xcs.SIG_SAMPLES = a; }
 	void set_ga_subsumption(_Bool a) { xcs.GA_SUBSUMPTION = a; }
 	void set_set_subsumption(_Bool a) { xcs.SET_SUBSUMPTION = a; }
 };
@@ -248,11 +306,14 @@ BOOST_PYTHON_MODULE(xcsf)
 		.def("fit", fit1)
 		.def("fit", fit2)
 		.def("predict", &XCS::predict)
+		.def("condense", &XCS::condense)
 		.add_property("POP_INIT", &XCS::get_pop_init, &XCS::set_pop_init)
 		.add_property("THETA_MNA", &XCS::get_theta_mna, &XCS::set_theta_mna)
 		.add_property("MAX_TRIALS", &XCS::get_max_trials, &XCS::set_max_trials)
 		.add_property("PERF_AVG_TRIALS", &XCS::get_perf_avg_trials, &XCS::set_perf_avg_trials)
 		.add_property("POP_SIZE", &XCS::get_pop_size, &XCS::set_pop_size)
+		.add_property("MAX_POP_BYTES", &XCS::get_max_pop_bytes, &XCS::set_max_pop_bytes)
+		.add_property("MATCH_CACHE_BYTES", &XCS::get_match_cache_bytes, &XCS::set_match_cache_bytes)
 		.add_property("ALPHA", &XCS::get_alpha, &XCS::set_alpha)
 		.add_property("BETA", &XCS::get_beta, &XCS::set_beta)
 		.add_property("DELTA", &XCS::get_delta, &XCS::set_delta)
@@ -273,6 +334,8 @@ BOOST_PYTHON_MODULE(xcsf)
 		.add_property("NUM_SAM", &XCS::get_num_sam, &XCS::set_num_sam)
 		.add_property("MAX_CON", &XCS::get_max_con, &XCS::set_max_con)
 		.add_property("MIN_CON", &XCS::get_min_con, &XCS::set_min_con)
+		.add_property("P_DONTCARE", &XCS::get_p_dontcare, &XCS::set_p_dontcare)
+		.add_property("THETA_ENV", &XCS::get_theta_env, &XCS::set_theta_env)
 		.add_property("S_MUTATION", &XCS::get_s_mutation, &XCS::set_s_mutation)
 		.add_property("NUM_HIDDEN_NEURONS", &XCS::get_num_hidden_neurons, &XCS::set_num_hidden_neurons)
 		.add_property("HIDDEN_NEURON_ACTIVATION", &XCS::get_hidden_neuron_activation, &XCS::set_hidden_neuron_activation)
@@ -284,10 +347,19 @@ BOOST_PYTHON_MODULE(xcsf)
 		.add_property("RLS_SCALE_FACTOR", &XCS::get_rls_scale_factor, &XCS::set_rls_scale_factor)
 		.add_property("RLS_LAMBDA", &XCS::get_rls_lambda, &XCS::set_rls_lambda)
 		.add_property("THETA_SUB", &XCS::get_theta_sub, &XCS::set_theta_sub)
+		.add_property("SIG_SAMPLES", &XCS::get_sig_samples, &XCS::set_sig_samples)
 		.add_property("GA_SUBSUMPTION", &XCS::get_ga_subsumption, &XCS::set_ga_subsumption)
 		.add_property("SET_SUBSUMPTION", &XCS::get_set_subsumption, &XCS::set_set_subsumption)
 		.def("pop_num", &XCS::get_pop_num)
 		.def("pop_num_sum", &XCS::get_pop_num_sum)
+		.def("pop_bytes", &XCS::get_pop_bytes)
+		.def("pop_total_fit", &XCS::get_pop_total_fit)
+		.def("env_rejects", &XCS::get_env_rejects)
+		.def("env_passes", &XCS::get_env_passes)
+		.def("covers", &XCS::get_covers)
+		.def("cover_tries", &XCS::get_cover_tries)
+		.def("cover_built", &XCS::get_cover_built)
+		.def("pop_avg_mu", &XCS::get_pop_avg_mu)
 		.def("time", &XCS::get_time)
 		.def("num_x_vars", &XCS::get_num_x_vars)
 		.def("num_y_vars", &XCS::get_num_y_vars)
@@ -28,10 +28,10 @@
 #include "cl.h"
 #include "dgp.h"
 #include "rule_dgp.h"
+#include "cl_index.h"
 
 typedef struct RULE_DGP_COND {
 	GRAPH dgp;
-	_Bool m;
 	double *mu;
 } RULE_DGP_COND;
 
@@ -47,6 +47,13 @@ void rule_dgp_cond_init(XCSF *xcsf, CL *c)
 	sam_init(xcsf, &cond->mu);
 }
 
+void rule_dgp_cond_reinit(XCSF *xcsf, CL *c)
+{
+	RULE_DGP_COND *cond = c->cond;
+	graph_reinit(xcsf, &cond->dgp);
+	sam_reinit(xcsf, cond->mu);
+}
+
 void rule_dgp_cond_free(XCSF *xcsf, CL *c)
 {
 	RULE_DGP_COND *cond = c->cond;
@@ -62,6 +69,33 @@ double rule_dgp_cond_mu(XCSF *xcsf, CL *c, int m)
 	return cond->mu[m];
 }
 
+size_t rule_dgp_cond_bytes(XCSF *xcsf)
+{
+	// allocated separately from the classifier
+	(void)xcsf;
+	return 0;
+}
+
+size_t rule_dgp_cond_heap(XCSF *xcsf, CL *c)
+{
+	RULE_DGP_COND *cond = c->cond;
+	return sizeof(RULE_DGP_COND) + sizeof(double) * xcsf->NUM_SAM +
+		graph_heap(xcsf, &cond->dgp);
+}
+
+uint64_t rule_dgp_cond_hash(XCSF *xcsf, CL *c)
+{
+	RULE_DGP_COND *cond = c->cond;
+	return graph_hash(xcsf, &cond->dgp);
+}
+
+_Bool rule_dgp_cond_equal(XCSF *xcsf, CL *c1, CL *c2)
+{
+	RULE_DGP_COND *cond1 = c1->cond;
+	RULE_DGP_COND *cond2 = c2->cond;
+	return graph_equal(xcsf, &cond1->dgp, &cond2->dgp);
+}
+
 void rule_dgp_cond_copy(XCSF *xcsf, CL *to, CL *from)
 {
 	RULE_DGP_COND *to_cond = to->cond;
@@ -78,10 +112,21 @@ void rule_dgp_cond_rand(XCSF *xcsf, CL *c)
 
 void rule_dgp_cond_cover(XCSF *xcsf, CL *c, double *x)
 {
-	// generates random graphs until the network matches for input state
-	do {
+	// generates random graphs until the network matches for input state;
+	// after COVER_TRIES failures the matching node is rewired so that it
+	// does, and the graph updated again for the predictions
+	RULE_DGP_COND *cond = c->cond;
+	_Bool match = false;
+	for(int i = 0; i < COVER_TRIES && !match; i++) {
 		rule_dgp_cond_rand(xcsf, c);
-	} while(!rule_dgp_cond_match(xcsf, c, x));
+		match = rule_dgp_cond_match(xcsf, c, x);
+		xcsf->cover_tries++;
+	}
+	if(!match) {
+		graph_cover(xcsf, &cond->dgp, x, 0.5);
+		rule_dgp_cond_match(xcsf, c, x);
+		xcsf->cover_built++;
+	}
 }
 
 _Bool rule_dgp_cond_match(XCSF *xcsf, CL *c, double *x)
@@ -90,21 +135,11 @@ _Bool rule_dgp_cond_match(XCSF *xcsf, CL *c, double *x)
 	RULE_DGP_COND *cond = c->cond;
 	graph_update(xcsf, &cond->dgp, x);
 	if(graph_output(xcsf, &cond->dgp, 0) > 0.5) {
-		cond->m = true;
-	}
-	else {
-		cond->m = false;
+		return true;
 	}
-	return cond->m;
+	return false;
 }    
 
-_Bool rule_dgp_cond_match_state(XCSF *xcsf, CL *c)
-{
-	(void)xcsf;
-	RULE_DGP_COND *cond = c->cond;
-	return cond->m;
-}
-
 _Bool rule_dgp_cond_mutate(XCSF *xcsf, CL *c)
 {
 	RULE_DGP_COND *cond = c->cond;
@@ -117,6 +152,16 @@ _Bool rule_dgp_cond_mutate(XCSF *xcsf, CL *c)
 	return mod;
 }
 
+_Bool rule_dgp_cond_box(XCSF *xcsf, CL *c, double *lower, double *upper)
+{
+	// no bounding box of the matching region is available
+	(void)xcsf;
+	(void)c;
+	(void)lower;
+	(void)upper;
+	return false;
+}
+
 _Bool rule_dgp_cond_crossover(XCSF *xcsf, CL *c1, CL *c2)
 {
 	(void)xcsf;
@@ -146,6 +191,12 @@ void rule_dgp_pred_init(XCSF *xcsf, CL *c)
 	c->pred = pred;
 }
 
+void rule_dgp_pred_reinit(XCSF *xcsf, CL *c)
+{
+	(void)xcsf;
+	(void)c;
+}
+
 void rule_dgp_pred_free(XCSF *xcsf, CL *c)
 {
 	(void)xcsf;
@@ -187,6 +238,19 @@ double rule_dgp_pred_pre(XCSF *xcsf, CL *c, int p)
 	return pred->pre[p];
 }
 
+size_t rule_dgp_pred_bytes(XCSF *xcsf)
+{
+	// allocated separately from the classifier
+	(void)xcsf;
+	return 0;
+}
+
+size_t rule_dgp_pred_heap(XCSF *xcsf, CL *c)
+{
+	(void)c;
+	return sizeof(RULE_DGP_PRED) + sizeof(double) * xcsf->num_y_vars;
+}
+
 void rule_dgp_pred_print(XCSF *xcsf, CL *c)
 {
 	(void)xcsf;
@@ -16,47 +16,63 @@
  */
 
 _Bool rule_dgp_cond_crossover(XCSF *xcsf, CL *c1, CL *c2);
+_Bool rule_dgp_cond_equal(XCSF *xcsf, CL *c1, CL *c2);
 _Bool rule_dgp_cond_general(XCSF *xcsf, CL *c1, CL *c2);
 _Bool rule_dgp_cond_match(XCSF *xcsf, CL *c, double *x);
-_Bool rule_dgp_cond_match_state(XCSF *xcsf, CL *c);
 _Bool rule_dgp_cond_mutate(XCSF *xcsf, CL *c);
+_Bool rule_dgp_cond_box(XCSF *xcsf, CL *c, double *lower, double *upper);
 void rule_dgp_cond_copy(XCSF *xcsf, CL *to, CL *from);
 void rule_dgp_cond_cover(XCSF *xcsf, CL *c, double *x);
 void rule_dgp_cond_free(XCSF *xcsf, CL *c);
 void rule_dgp_cond_init(XCSF *xcsf, CL *c);
 void rule_dgp_cond_print(XCSF *xcsf, CL *c);
 void rule_dgp_cond_rand(XCSF *xcsf, CL *c);
+void rule_dgp_cond_reinit(XCSF *xcsf, CL *c);
 double rule_dgp_cond_mu(XCSF *xcsf, CL *c, int m);
+size_t rule_dgp_cond_bytes(XCSF *xcsf);
+size_t rule_dgp_cond_heap(XCSF *xcsf, CL *c);
+uint64_t rule_dgp_cond_hash(XCSF *xcsf, CL *c);
 
 static struct CondVtbl const rule_dgp_cond_vtbl = {
 	&rule_dgp_cond_crossover,
+	&rule_dgp_cond_equal,
 	&rule_dgp_cond_general,
 	&rule_dgp_cond_match,
-	&rule_dgp_cond_match_state,
 	&rule_dgp_cond_mutate,
+	&rule_dgp_cond_box,
 	&rule_dgp_cond_mu,
+	&rule_dgp_cond_bytes,
+	&rule_dgp_cond_heap,
+	&rule_dgp_cond_hash,
 	&rule_dgp_cond_copy,
 	&rule_dgp_cond_cover,
 	&rule_dgp_cond_free,
 	&rule_dgp_cond_init,
 	&rule_dgp_cond_print,
-	&rule_dgp_cond_rand
+	&rule_dgp_cond_rand,
+	&rule_dgp_cond_reinit
 };      
 
 double rule_dgp_pred_pre(XCSF *xcsf, CL *c, int p);
+size_t rule_dgp_pred_bytes(XCSF *xcsf);
+size_t rule_dgp_pred_heap(XCSF *xcsf, CL *c);
 double *rule_dgp_pred_compute(XCSF *xcsf, CL *c, double *x);
 void rule_dgp_pred_copy(XCSF *xcsf, CL *to,  CL *from);
 void rule_dgp_pred_free(XCSF *xcsf, CL *c);
 void rule_dgp_pred_init(XCSF *xcsf, CL *c);
 void rule_dgp_pred_print(XCSF *xcsf, CL *c);
+void rule_dgp_pred_reinit(XCSF *xcsf, CL *c);
 void rule_dgp_pred_update(XCSF *xcsf, CL *c, double *y, double *x);
 
 static struct PredVtbl const rule_dgp_pred_vtbl = {
 	&rule_dgp_pred_compute,
 	&rule_dgp_pred_pre,
+	&rule_dgp_pred_bytes,
+	&rule_dgp_pred_heap,
 	&rule_dgp_pred_copy,
 	&rule_dgp_pred_free,
 	&rule_dgp_pred_init,
 	&rule_dgp_pred_print,
+	&rule_dgp_pred_reinit,
 	&rule_dgp_pred_update
 };
@@ -31,10 +31,10 @@
 #include "cl.h"
 #include "neural.h"
 #include "rule_neural.h"
+#include "cl_index.h"
 
 typedef struct RULE_NEURAL_COND {
     BPN bpn;
-    _Bool m;
     double *mu;
 } RULE_NEURAL_COND;
 
@@ -52,6 +52,13 @@ void rule_neural_cond_init(XCSF *xcsf, CL *c)
     sam_init(xcsf, &cond->mu);
 }
 
+void rule_neural_cond_reinit(XCSF *xcsf, CL *c)
+{
+    RULE_NEURAL_COND *cond = c->cond;
+    neural_reinit(xcsf, &cond->bpn);
+    sam_reinit(xcsf, cond->mu);
+}
+
 void rule_neural_cond_free(XCSF *xcsf, CL *c)
 {
     RULE_NEURAL_COND *cond = c->cond;
@@ -67,6 +74,33 @@ double rule_neural_cond_mu(XCSF *xcsf, CL *c, int m)
     return cond->mu[m];
 }
 
+size_t rule_neural_cond_bytes(XCSF *xcsf)
+{
+    // allocated separately from the classifier
+    (void)xcsf;
+    return 0;
+}
+
+size_t rule_neural_cond_heap(XCSF *xcsf, CL *c)
+{
+    RULE_NEURAL_COND *cond = c->cond;
+    return sizeof(RULE_NEURAL_COND) + sizeof(double) * xcsf->NUM_SAM +
+        neural_heap(xcsf, &cond->bpn);
+}
+
+uint64_t rule_neural_cond_hash(XCSF *xcsf, CL *c)
+{
+    RULE_NEURAL_COND *cond = c->cond;
+    return neural_hash(xcsf, &cond->bpn);
+}
+
+_Bool rule_neural_cond_equal(XCSF *xcsf, CL *c1, CL *c2)
+{
+    RULE_NEURAL_COND *cond1 = c1->cond;
+    RULE_NEURAL_COND *cond2 = c2->cond;
+    return neural_equal(xcsf, &cond1->bpn, &cond2->bpn);
+}
+
 void rule_neural_cond_copy(XCSF *xcsf, CL *to, CL *from)
 {
     RULE_NEURAL_COND *to_cond = to->cond;
@@ -83,10 +117,21 @@ void rule_neural_cond_rand(XCSF *xcsf, CL *c)
 
 void rule_neural_cond_cover(XCSF *xcsf, CL *c, double *x)
 {
-    // generates random weights until the network matches for input state
-    do {
+    // generates random weights until the network matches for input state;
+    // after COVER_TRIES failures the bias of the matching output is shifted
+    // so that it does, and the network propagated again for the predictions
+    RULE_NEURAL_COND *cond = c->cond;
+    _Bool match = false;
+    for(int i = 0; i < COVER_TRIES && !match; i++) {
         rule_neural_cond_rand(xcsf, c);
-    } while(!rule_neural_cond_match(xcsf, c, x));
+        match = rule_neural_cond_match(xcsf, c, x);
+        xcsf->cover_tries++;
+    }
+    if(!match) {
+        neural_bias(xcsf, &cond->bpn, 0, log(3.0) + 0.1 + drand());
+        rule_neural_cond_match(xcsf, c, x);
+        xcsf->cover_built++;
+    }
 }
 
 _Bool rule_neural_cond_match(XCSF *xcsf, CL *c, double *x)
@@ -95,21 +140,11 @@ _Bool rule_neural_cond_match(XCSF *xcsf, CL *c, double *x)
     RULE_NEURAL_COND *cond = c->cond;
     neural_propagate(xcsf, &cond->bpn, x);
     if(neural_output(xcsf, &cond->bpn, 0) > 0.5) {
-        cond->m = true;
-    }
-    else {
-        cond->m = false;
+        return true;
     }
-    return cond->m;
+    return false;
 }    
 
-_Bool rule_neural_cond_match_state(XCSF *xcsf, CL *c)
-{
-    (void)xcsf;
-    RULE_NEURAL_COND *cond = c->cond;
-    return cond->m;
-}
-
 _Bool rule_neural_cond_mutate(XCSF *xcsf, CL *c)
 {
     RULE_NEURAL_COND *cond = c->cond;
@@ -133,6 +168,16 @@ _Bool rule_neural_cond_mutate(XCSF *xcsf, CL *c)
     return mod;
 }
 
+_Bool rule_neural_cond_box(XCSF *xcsf, CL *c, double *lower, double *upper)
+{
+    // no bounding box of the matching region is available
+    (void)xcsf;
+    (void)c;
+    (void)lower;
+    (void)upper;
+    return false;
+}
+
 _Bool rule_neural_cond_crossover(XCSF *xcsf, CL *c1, CL *c2)
 {
     (void)xcsf;
@@ -157,11 +202,17 @@ void rule_neural_cond_print(XCSF *xcsf, CL *c)
 
 void rule_neural_pred_init(XCSF *xcsf, CL *c)
 {
-    RULE_NEURAL_PRED *pred = malloc(sizeof(RULE_NEURAL_COND));
+    RULE_NEURAL_PRED *pred = malloc(sizeof(RULE_NEURAL_PRED));
     pred->pre = malloc(sizeof(double) * xcsf->num_y_vars);
     c->pred = pred;
 }
 
+void rule_neural_pred_reinit(XCSF *xcsf, CL *c)
+{
+    (void)xcsf;
+    (void)c;
+}
+
 void rule_neural_pred_free(XCSF *xcsf, CL *c)
 {
     (void)xcsf;
@@ -203,6 +254,19 @@ double rule_neural_pred_pre(XCSF *xcsf, CL *c, int p)
     return pred->pre[p];
 }
 
+size_t rule_neural_pred_bytes(XCSF *xcsf)
+{
+    // allocated separately from the classifier
+    (void)xcsf;
+    return 0;
+}
+
+size_t rule_neural_pred_heap(XCSF *xcsf, CL *c)
+{
+    (void)c;
+    return sizeof(RULE_NEURAL_PRED) + sizeof(double) * xcsf->num_y_vars;
+}
+
 void rule_neural_pred_print(XCSF *xcsf, CL *c)
 {
     (void)xcsf;
@@ -32,14 +32,21 @@
 #include "random.h"
 
 double gasdev();
+void sam_reinit(XCSF *xcsf, double *mu);
 
 void sam_init(XCSF *xcsf, double **mu)
 {
 	if(xcsf->NUM_SAM > 0) {
 		*mu = malloc(sizeof(double) * xcsf->NUM_SAM);
-		for(int i = 0; i < xcsf->NUM_SAM; i++) {
-			(*mu)[i] = drand();
-		}
+		sam_reinit(xcsf, *mu);
+	}
+}
+
+void sam_reinit(XCSF *xcsf, double *mu)
+{
+	// randomises the mutation rates of a recycled classifier
+	for(int i = 0; i < xcsf->NUM_SAM; i++) {
+		mu[i] = drand();
 	}
 }
 
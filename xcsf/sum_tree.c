@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2019 Richard Preen <rpreen@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **************
+ * Description: 
+ **************
+ * The binary sum tree module.
+ *
+ * Stores a non-negative value for each slot in the leaves of a complete
+ * binary tree whose internal nodes hold the sum of their children. Setting a
+ * value and finding the slot at a given point of the cumulative sum (roulette
+ * wheel selection) both take O(log N). Internal nodes are recomputed from
+ * their children rather than adjusted by differences so that the sums do not
+ * drift over many updates.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "data_structures.h"
+#include "sum_tree.h"
+
+#define SUM_TREE_MIN_CAPACITY 16 // initial number of leaves
+
+void sum_tree_grow(SUM_TREE *t, int i);
+
+void sum_tree_init(SUM_TREE *t)
+{
+	t->node = NULL;
+	t->capacity = 0;
+}
+
+void sum_tree_free(SUM_TREE *t)
+{
+	free(t->node);
+	sum_tree_init(t);
+}
+
+void sum_tree_set(SUM_TREE *t, int i, double v)
+{
+	// sets the value of slot i and updates the sums above it
+	if(i >= t->capacity) {
+		sum_tree_grow(t, i);
+	}
+	int n = t->capacity + i;
+	t->node[n] = v;
+	for(n /= 2; n > 0; n /= 2) {
+		t->node[n] = t->node[2*n] + t->node[2*n+1];
+	}
+}
+
+double sum_tree_get(SUM_TREE *t, int i)
+{
+	if(i >= t->capacity) {
+		return 0.0;
+	}
+	return t->node[t->capacity + i];
+}
+
+double sum_tree_total(SUM_TREE *t)
+{
+	if(t->capacity == 0) {
+		return 0.0;
+	}
+	return t->node[1];
+}
+
+int sum_tree_search(SUM_TREE *t, double p)
+{
+	// returns the slot whose cumulative sum interval contains point p
+	int n = 1;
+	while(n < t->capacity) {
+		double left = t->node[2*n];
+		if(p < left || t->node[2*n+1] <= 0.0) {
+			n = 2*n;
+		}
+		else {
+			p -= left;
+			n = 2*n+1;
+		}
+	}
+	return n - t->capacity;
+}
+
+void sum_tree_grow(SUM_TREE *t, int i)
+{
+	// doubles the number of leaves until slot i fits and rebuilds the sums
+	int cap = t->capacity;
+	if(cap < SUM_TREE_MIN_CAPACITY) {
+		cap = SUM_TREE_MIN_CAPACITY;
+	}
+	while(cap <= i) {
+		cap *= 2;
+	}
+	double *node = calloc(2 * cap, sizeof(double));
+	if(t->capacity > 0) {
+		memcpy(&node[cap], &t->node[t->capacity], sizeof(double) * t->capacity);
+	}
+	for(int n = cap-1; n > 0; n--) {
+		node[n] = node[2*n] + node[2*n+1];
+	}
+	free(t->node);
+	t->node = node;
+	t->capacity = cap;
+}
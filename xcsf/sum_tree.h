@@ -0,0 +1,23 @@
+/*
+ * Copyright (C) 2019 Richard Preen <rpreen@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+double sum_tree_get(SUM_TREE *t, int i);
+double sum_tree_total(SUM_TREE *t);
+int sum_tree_search(SUM_TREE *t, double p);
+void sum_tree_free(SUM_TREE *t);
+void sum_tree_init(SUM_TREE *t);
+void sum_tree_set(SUM_TREE *t, int i, double v);